@@ -4,7 +4,10 @@
 #include <stack>
 #include <array>
 #include <string>
+#include <utility>
 #include <iostream>
+#include <type_traits>
+#include "ObjectPool.h"
 
 #define LINE_INFO (std::string(__FUNCTION__) + " in " + std::string(__FILE__) +"(line : " + std::to_string(__LINE__)+ ")")
 
@@ -79,6 +82,9 @@ namespace AdjacencyMultiList
 	protected:
 		//Doubly-Multi-Linked-List's first element
 		Edge<VT, ET>* front = nullptr;
+
+		//Doubly-Multi-Linked-List's last element, kept for O(1) append
+		Edge<VT, ET>* back = nullptr;
 		
 		int degree = 0;
 
@@ -105,9 +111,10 @@ namespace AdjacencyMultiList
 		void ResetEdgeMark();
 
 	protected:
-		/**	internal fuction to quickly delete all edges in graph.
+		/**	internal fuction to quickly forget all edges in graph.
+		*@note	memory of edges is owned by the edge pool of Graph, so this function doesn't free them.
 		*/
-		void _DeleteEdge();
+		void _ResetEdge();
 	};
 
 	/**	Edge Class for Adjacency Multi List Graph
@@ -182,6 +189,21 @@ namespace AdjacencyMultiList
 		void append(Vertex<VT, ET>* target, Edge<VT, ET>* next_edge);
 	};
 
+	/**	Weight accessor which returns the data of edge itself.
+	*	can be passed as GetEdgeWeight of every algorithm when the data of edge is its weight, and is inlined unlike a function pointer.
+	*/
+	struct EdgeData
+	{
+		template<typename VT, typename ET>
+		const ET& operator()(Edge<VT, ET>* const &edge) const { return edge->data; }
+	};
+
+	/**	type of weight returned by GetEdgeWeight for the edges of Graph<VT, ET>
+	*@tparam	WeightFunctionT	function pointer, lambda or object called as GetEdgeWeight(edge) with (Edge<VT, ET>* &)
+	*/
+	template<typename WeightFunctionT, typename VT, typename ET>
+	using EdgeWeightType = typename std::decay<decltype(std::declval<WeightFunctionT&>()(std::declval<Edge<VT, ET>*&>()))>::type;
+
 
 	/**	Adjacency Multi List Graph
 	*@tparam	VT	type of data witch will be stored inside vertex
@@ -207,6 +229,11 @@ namespace AdjacencyMultiList
 
 		int current_edge_number = 0;
 
+		//chunked storage of every edge and vertex owned by this graph
+		ObjectPool<Edge<VT, ET>> edge_pool;
+
+		ObjectPool<Vertex<VT, ET>> vertex_pool;
+
 		//Լ
 	public:
 		//return number of vertices in this graph
@@ -229,6 +256,13 @@ namespace AdjacencyMultiList
 		void Connect(Vertex<VT, ET>* vertex1, Vertex<VT, ET>* vertex2);
 
 		void Connect(int i, int j);
+
+		/**	connect every pair of vertex indices in given order.
+		*	storage for the edges is reserved at once, and each edge is appended in O(1).
+		*@param	edge_pairs	pairs of vertex indices in vertex_list
+		*@throw	GraphException if any index is out of range or a pair has same index. in that case, nothing is connected.
+		*/
+		void ConnectBatch(const std::vector<std::pair<int, int>>& edge_pairs);
 		
 		void Disconnect(Vertex<VT, ET>* vertex1, Vertex<VT, ET>* vertex2);
 
@@ -264,10 +298,6 @@ namespace AdjacencyMultiList
 	template<typename VT, typename ET>
 	inline Vertex<VT, ET>::~Vertex()
 	{
-		if(front != nullptr)
-		{
-			_DeleteEdge();
-		}
 	}
 
 	template<typename VT, typename ET>
@@ -293,12 +323,6 @@ namespace AdjacencyMultiList
 	template<typename VT, typename ET>
 	inline Edge<VT, ET>* Vertex<VT, ET>::GetBack()
 	{
-		if(front == nullptr) return nullptr;
-		Edge<VT, ET>* back = front;
-		while(back->GetNext(this) != nullptr)
-		{
-			back = back->GetNext(this);
-		}
 		return back;
 	}
 
@@ -340,32 +364,10 @@ namespace AdjacencyMultiList
 	}
 
 	template<typename VT, typename ET>
-	inline void Vertex<VT, ET>::_DeleteEdge()
+	inline void Vertex<VT, ET>::_ResetEdge()
 	{
-		if(front == nullptr) return;
-		Edge<VT, ET>* current = front;
-		std::stack<Edge<VT, ET>*> edge_stack;
-		while(current != nullptr)
-		{
-			int selector = current->FindIndex(this);
-			current->mark = (current->vertex[!selector] == nullptr) ? true : false;
-			current->vertex[selector] == nullptr;
-			edge_stack.push(current);
-			current = std::exchange(current->next[selector], nullptr);
-		}
-
-		while(!edge_stack.empty())
-		{
-			current = edge_stack.top();
-			if(current->mark)
-			{
-				delete current;
-				current = nullptr;
-			}
-			edge_stack.pop();
-		}
-
 		front = nullptr;
+		back = nullptr;
 		degree = 0;
 	}
 
@@ -468,7 +470,7 @@ namespace AdjacencyMultiList
 	template<typename VT, typename ET>
 	inline Graph<VT, ET>::~Graph()
 	{
-
+		ClearVertex();
 	}
 
 	template<typename VT, typename ET>
@@ -480,7 +482,7 @@ namespace AdjacencyMultiList
 		vertex_list.reserve(init_vertex_number);
 		for(int i = 0; i < target_vertex_number; i++)
 		{
-			vertex_list.push_back(new Vertex<VT, ET>(init_data));
+			vertex_list.push_back(vertex_pool.Create(init_data));
 		}
 	}
 
@@ -493,7 +495,7 @@ namespace AdjacencyMultiList
 		vertex_list.reserve(init_vertex_number);
 		for(int i = 0; i < target_vertex_number; i++)
 		{
-			vertex_list.push_back(new Vertex<VT, ET>());
+			vertex_list.push_back(vertex_pool.Create());
 		}
 	}
 
@@ -503,7 +505,7 @@ namespace AdjacencyMultiList
 		ClearVertex();
 		for(int i = 0; i < target_vertex_number; i++)
 		{
-			vertex_list.push_back(new Vertex<VT, ET>());
+			vertex_list.push_back(vertex_pool.Create());
 		}
 	}
 
@@ -556,10 +558,10 @@ namespace AdjacencyMultiList
 	{
 		if(vertex1 == nullptr || vertex2 == nullptr) throw std::invalid_argument("vertex");
 
-		Edge<VT, ET>* back1 = vertex1->GetBack();
-		Edge<VT, ET>* back2 = vertex2->GetBack();
+		Edge<VT, ET>* back1 = vertex1->back;
+		Edge<VT, ET>* back2 = vertex2->back;
 		
-		Edge<VT, ET>* connector = new Edge<VT, ET>(vertex1, vertex2);
+		Edge<VT, ET>* connector = edge_pool.Create(vertex1, vertex2);
 		if(nullptr == back1)
 		{
 			vertex1->front = connector;
@@ -568,6 +570,7 @@ namespace AdjacencyMultiList
 		{
 			back1->append(vertex1, connector);
 		}
+		vertex1->back = connector;
 
 		if(nullptr == back2)
 		{
@@ -577,6 +580,7 @@ namespace AdjacencyMultiList
 		{
 			back2->append(vertex2, connector);
 		}
+		vertex2->back = connector;
 		vertex1->degree++;
 		vertex2->degree++;
 
@@ -596,6 +600,27 @@ namespace AdjacencyMultiList
 		this->Connect(vertex_list[i], vertex_list[j]);
 	}
 
+	template<typename VT, typename ET>
+	inline void Graph<VT, ET>::ConnectBatch(const std::vector<std::pair<int, int>>& edge_pairs)
+	{
+		const int network_size = int(vertex_list.size());
+		for(const std::pair<int, int>& edge_pair : edge_pairs)
+		{
+			if(edge_pair.first < 0 || edge_pair.second < 0 || edge_pair.first >= network_size || edge_pair.second >= network_size)
+				throw GraphException(LINE_INFO, "given index is out of range");
+
+			if(edge_pair.first == edge_pair.second)
+				throw GraphException(LINE_INFO, "same index");
+		}
+
+		edge_pool.Reserve(edge_pairs.size());
+
+		for(const std::pair<int, int>& edge_pair : edge_pairs)
+		{
+			this->Connect(vertex_list[edge_pair.first], vertex_list[edge_pair.second]);
+		}
+	}
+
 	template<typename VT, typename ET>
 	inline void Graph<VT, ET>::Disconnect(Vertex<VT, ET>* vertex1, Vertex<VT, ET>* vertex2)
 	{
@@ -643,11 +668,15 @@ namespace AdjacencyMultiList
 				int selector = next_edge->FindIndex(target_vertex);
 				next_edge->before[selector] = before_edge;
 			}
+			else
+			{
+				target_vertex->back = before_edge;
+			}
 
 			target_vertex->degree--;
 		}
 
-		delete target_edge;
+		edge_pool.Destroy(target_edge);
 		target_edge = nullptr;
 		--current_edge_number;
 
@@ -667,7 +696,7 @@ namespace AdjacencyMultiList
 			PopEdge(target->GetFront(), target);
 		}
 
-		delete target;
+		vertex_pool.Destroy(target);
 		target = nullptr;
 
 		vertex_list.erase(target_iter);
@@ -701,7 +730,7 @@ namespace AdjacencyMultiList
 		{
 			PopEdge(target_vertex->front, target_vertex);
 		}
-		delete target_vertex;
+		vertex_pool.Destroy(target_vertex);
 		target_vertex = nullptr;
 		*target_iterator = nullptr;
 
@@ -712,21 +741,43 @@ namespace AdjacencyMultiList
 	template<typename VT, typename ET>
 	inline void Graph<VT, ET>::ClearVertex()
 	{
+		ClearEdge();
 		for(Vertex<VT, ET>* vertex : vertex_list)
 		{
-			vertex->_DeleteEdge();
-			delete vertex;
+			vertex_pool.Destroy(vertex);
 		}
 		vertex_list.clear();
-		current_edge_number = 0;
+		vertex_pool.Reset();
 	}
 
 	template<typename VT, typename ET>
 	inline void Graph<VT, ET>::ClearEdge()
 	{
+		//edges with non-trivial data need their destructor. each edge is destroyed once, from the side of vertex[0].
+		if(!std::is_trivially_destructible<Edge<VT, ET>>::value)
+		{
+			std::vector<Edge<VT, ET>*> edges;
+			edges.reserve(current_edge_number);
+			for(Vertex<VT, ET>* vertex : vertex_list)
+			{
+				Edge<VT, ET>* current_edge = vertex->front;
+				while(current_edge != nullptr)
+				{
+					if(current_edge->vertex[0] == vertex) edges.push_back(current_edge);
+					current_edge = current_edge->GetNext(vertex);
+				}
+			}
+			for(Edge<VT, ET>* edge : edges)
+			{
+				edge_pool.Destroy(edge);
+			}
+		}
+
+		//every edge memory is returned at once, without walking the incident lists
+		edge_pool.Reset();
 		for(Vertex<VT, ET>* vertex : vertex_list)
 		{
-			vertex->_DeleteEdge();
+			vertex->_ResetEdge();
 		}
 		current_edge_number = 0;
 	}
@@ -0,0 +1,399 @@
+#pragma once
+
+#include "AdjacencyMultiList.h"
+#include "CompressedGraph.h"
+#include "ParallelShortestPath.h"
+#include "ThreadPool.h"
+#include <vector>
+#include <array>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+
+namespace ShortestPath
+{
+	namespace AML = AdjacencyMultiList;
+
+	/**	Direction-optimizing breadth first search (Beamer) on the Compressed Sparse Row snapshot of graph, run by several threads.
+	*	small levels are expanded top-down from a queue of the frontier. big levels are expanded bottom-up : every vertex not visited yet
+	*	looks for a parent in the bitmap of the frontier, and stops at the first one it finds. on graphs of small diameter,
+	*	most edges are never looked at in the few big levels.
+	*@param	distances_return	hop distance of each vertex index. -1 for unreachable vertices
+	*@param	parents_return		previous vertex index of each vertex index. -1 for start_vertex and unreachable vertices
+	*@param	thread_number		0 uses std::thread::hardware_concurrency(). graphs smaller than parallel_threshold vertices are searched by one thread
+	*@note	the result doesn't depend on thread_number. the parent of a vertex found top-down is the smallest index in the frontier,
+	*		and the one found bottom-up is the first in its adjacency. both are returned empty if start_vertex isn't in graph.
+	*/
+	template<typename VT, typename ET, typename WeightT>
+	void BreadthFirstSearch(const AML::CompressedGraph<VT, ET, WeightT>* target_graph,
+							AML::Vertex<VT, ET>* start_vertex,
+							std::vector<int>& distances_return,
+							std::vector<int>& parents_return,
+							int thread_number = 0)
+	{
+		//thresholds of Beamer. goes bottom-up when the frontier grows and its edges are more than (unexplored edges / alpha),
+		//and back to top-down when the frontier shrinks under (vertices / beta)
+		const long long alpha = 15;
+		const long long beta = 18;
+
+		if(target_graph == nullptr) throw std::invalid_argument("target_graph == nullptr");
+		distances_return.clear();
+		parents_return.clear();
+		if(!target_graph->Contains(start_vertex))
+			return;//if given vertex isn't in graph
+
+		const int network_size = target_graph->GetVertexNumber();
+		const std::vector<int>& offsets = target_graph->offsets;
+		const std::vector<int>& neighbors = target_graph->neighbors;
+		const int word_number = (network_size + 63) / 64;
+		const int start_index = start_vertex->index;
+
+		if(thread_number <= 0) thread_number = int(std::thread::hardware_concurrency());
+		if(thread_number <= 0 || network_size < parallel_threshold) thread_number = 1;
+		thread_number = std::min(thread_number, word_number);
+
+		distances_return.assign(network_size, -1);
+		parents_return.assign(network_size, -1);
+		distances_return[start_index] = 0;
+
+		//written by compare and swap in top-down levels, where several frontier vertices reach same vertex
+		std::vector<std::atomic<int>> parents(network_size);
+
+		//frontier of level k is in queues[k % 2] when it is expanded top-down, and in bitmaps[k % 2] when bottom-up
+		std::vector<int> queues[2] = {std::vector<int>(network_size), std::vector<int>(network_size)};
+		std::vector<std::uint64_t> bitmaps[2] = {std::vector<std::uint64_t>(word_number), std::vector<std::uint64_t>(word_number)};
+		queues[0][0] = start_index;
+
+		//vertices found by each thread in top-down levels, and the size and edges of the next frontier found by each thread
+		std::vector<std::vector<int>> local_queues(thread_number);
+		std::vector<int> local_counts(thread_number);
+		std::vector<long long> local_edges(thread_number);
+
+		ThreadBarrier barrier(thread_number);
+
+		auto Work = [&](int thread_id)
+		{
+			//each thread owns whole words of the bitmaps, so bottom-up levels write them without atomics
+			const int word_begin = int((long long)word_number * thread_id / thread_number);
+			const int word_end = int((long long)word_number * (thread_id + 1) / thread_number);
+			const int vertex_begin = word_begin * 64;
+			const int vertex_end = std::min(network_size, word_end * 64);
+			std::vector<int>& local_queue = local_queues[thread_id];
+
+			for(int i = vertex_begin; i < vertex_end; i++)
+			{
+				parents[i].store(-1, std::memory_order_relaxed);
+			}
+			barrier.Wait();
+
+			bool top_down = true;
+			int level = 0;
+			int frontier_size = 1;
+			long long unexplored_edges = (long long)neighbors.size() - target_graph->GetDegree(start_index);
+			while(true)
+			{
+				const std::vector<int>& frontier = queues[level & 1];
+				std::vector<int>& next_frontier = queues[(level + 1) & 1];
+				const std::vector<std::uint64_t>& frontier_bits = bitmaps[level & 1];
+				std::vector<std::uint64_t>& next_bits = bitmaps[(level + 1) & 1];
+
+				//distances are written only between the barriers, so they show the levels before this one
+				int count = 0;
+				long long edges = 0;
+				if(top_down)
+				{
+					local_queue.clear();
+					const int begin = int((long long)frontier_size * thread_id / thread_number);
+					const int end = int((long long)frontier_size * (thread_id + 1) / thread_number);
+					for(int i = begin; i < end; i++)
+					{
+						const int vertex = frontier[i];
+						for(int j = offsets[vertex]; j < offsets[vertex + 1]; j++)
+						{
+							const int neighbor = neighbors[j];
+							if(distances_return[neighbor] != -1) continue;
+							int parent = -1;
+							if(parents[neighbor].compare_exchange_strong(parent, vertex, std::memory_order_relaxed))
+							{
+								local_queue.push_back(neighbor);
+								edges += target_graph->GetDegree(neighbor);
+							}
+							else
+							{
+								//keep the smallest parent, so the tree doesn't depend on which thread came first
+								while(vertex < parent && !parents[neighbor].compare_exchange_weak(parent, vertex, std::memory_order_relaxed)){}
+							}
+						}
+					}
+					count = int(local_queue.size());
+				}
+				else
+				{
+					for(int word = word_begin; word < word_end; word++)
+					{
+						std::uint64_t bits = 0;
+						const int last = std::min(network_size, word * 64 + 64);
+						for(int vertex = word * 64; vertex < last; vertex++)
+						{
+							if(distances_return[vertex] != -1) continue;
+							for(int j = offsets[vertex]; j < offsets[vertex + 1]; j++)
+							{
+								const int neighbor = neighbors[j];
+								if((frontier_bits[neighbor >> 6] >> (neighbor & 63)) & 1)
+								{
+									parents[vertex].store(neighbor, std::memory_order_relaxed);
+									distances_return[vertex] = level + 1;
+									bits |= std::uint64_t(1) << (vertex & 63);
+									++count;
+									edges += target_graph->GetDegree(vertex);
+									break;
+								}
+							}
+						}
+						next_bits[word] = bits;
+					}
+				}
+				local_counts[thread_id] = count;
+				local_edges[thread_id] = edges;
+				barrier.Wait();
+
+				//every thread sums same values, so every thread makes same decision
+				int next_size = 0;
+				int offset = 0;
+				long long next_edges = 0;
+				for(int i = 0; i < thread_number; i++)
+				{
+					if(i == thread_id) offset = next_size;
+					next_size += local_counts[i];
+					next_edges += local_edges[i];
+				}
+				if(next_size == 0) break;
+				unexplored_edges -= next_edges;
+
+				const bool next_top_down = top_down
+					? !(next_size > frontier_size && next_edges > unexplored_edges / alpha)
+					: (next_size < frontier_size && next_size < network_size / beta);
+
+				if(top_down)
+				{
+					for(int vertex : local_queue)
+					{
+						distances_return[vertex] = level + 1;
+					}
+					if(next_top_down) std::copy(local_queue.begin(), local_queue.end(), next_frontier.begin() + offset);
+				}
+				else if(next_top_down)
+				{
+					//queue of the vertices found by this thread, in the order of index
+					for(int vertex = vertex_begin; vertex < vertex_end; vertex++)
+					{
+						if((next_bits[vertex >> 6] >> (vertex & 63)) & 1) next_frontier[offset++] = vertex;
+					}
+				}
+				barrier.Wait();
+
+				if(top_down && !next_top_down)
+				{
+					//bitmap of the next frontier from the distances, which are complete after the barrier
+					for(int word = word_begin; word < word_end; word++)
+					{
+						std::uint64_t bits = 0;
+						const int last = std::min(network_size, word * 64 + 64);
+						for(int vertex = word * 64; vertex < last; vertex++)
+						{
+							if(distances_return[vertex] == level + 1) bits |= std::uint64_t(1) << (vertex & 63);
+						}
+						next_bits[word] = bits;
+					}
+					barrier.Wait();
+				}
+
+				top_down = next_top_down;
+				frontier_size = next_size;
+				++level;
+			}
+
+			for(int i = vertex_begin; i < vertex_end; i++)
+			{
+				parents_return[i] = parents[i].load(std::memory_order_relaxed);
+			}
+		};
+
+		std::vector<std::thread> threads;
+		for(int i = 1; i < thread_number; i++)
+		{
+			threads.emplace_back(Work, i);
+		}
+		Work(0);
+		for(std::thread& thread : threads)
+		{
+			thread.join();
+		}
+	}
+
+	/**	breadth first search on the Compressed Sparse Row snapshot of given graph. the snapshot is built inside, O(V + E).
+	*	for repeated searches on same graph, build the snapshot once and pass it instead.
+	*@note	indices are the ones of vertex_list, as the snapshot calls ResetVertexIndex of target_graph.
+	*/
+	template<typename VT, typename ET>
+	void BreadthFirstSearch(AML::Graph<VT, ET>* target_graph,
+							AML::Vertex<VT, ET>* start_vertex,
+							std::vector<int>& distances_return,
+							std::vector<int>& parents_return,
+							int thread_number = 0)
+	{
+		AML::CompressedGraph<VT, ET> snapshot(target_graph, [](AML::Edge<VT, ET>*){ return 1.0f; });
+		BreadthFirstSearch(&snapshot, start_vertex, distances_return, parents_return, thread_number);
+	}
+
+	/**	Bit-parallel breadth first search from many sources at once (MS-BFS).
+	*	every vertex keeps a bitset with one bit per source. vertices reached by several searches at same level are expanded once for all of them,
+	*	so each edge is looked at once per level for the whole batch, instead of once per source.
+	*@tparam	WordNumber	a batch has up to 64 * WordNumber sources. the bitset of a vertex is WordNumber words, which the compiler can keep in one SIMD register.
+	*					buffers take 3 * 8 * WordNumber bytes per vertex
+	*@note	buffers are kept between calls of Run, so keep one object for the batches of each thread.
+	*/
+	template<int WordNumber = 4>
+	class MultiSourceBreadthFirstSearch
+	{
+	public:
+		static const int batch_size = 64 * WordNumber;
+
+		//bit i of word w is the source (64 * w + i) of the batch
+		typedef std::array<std::uint64_t, WordNumber> Bits;
+
+	protected:
+		//searches which have reached each vertex
+		std::vector<Bits> seen;
+
+		//searches which reached each vertex of the frontier at current level
+		std::vector<Bits> visits;
+
+		//searches which reach each vertex at next level. always zero outside of Run
+		std::vector<Bits> next_visits;
+
+		std::vector<int> frontier;
+		std::vector<int> next_frontier;
+
+	public:
+		/**	search from source_indices[0], ..., source_indices[source_number - 1] of the Compressed Sparse Row snapshot of graph.
+		*@param	Visit	called as Visit(level, vertex_index, bits) once for each vertex and level where some searches reach the vertex first,
+		*				with the bits of those searches. the sources are visited at level 0, and levels are visited in order.
+		*@note	O(V) to clear the buffers, plus O(E) for each level where some search is still going
+		*/
+		template<typename VT, typename ET, typename WeightT, typename VisitT>
+		void Run(const AML::CompressedGraph<VT, ET, WeightT>* target_graph, const int* source_indices, int source_number, VisitT Visit)
+		{
+			if(target_graph == nullptr) throw std::invalid_argument("target_graph == nullptr");
+			if(source_number < 0 || source_number > batch_size) throw std::invalid_argument("source_number is not in [0, batch_size]");
+
+			const int network_size = target_graph->GetVertexNumber();
+			const std::vector<int>& offsets = target_graph->offsets;
+			const std::vector<int>& neighbors = target_graph->neighbors;
+
+			seen.assign(network_size, Bits());
+			if(int(visits.size()) != network_size)
+			{
+				visits.assign(network_size, Bits());
+				next_visits.assign(network_size, Bits());
+			}
+
+			//checked before any bit is set, as visits must stay zero for the next Run
+			for(int i = 0; i < source_number; i++)
+			{
+				if(source_indices[i] < 0 || source_indices[i] >= network_size) throw std::invalid_argument("source is not in graph");
+			}
+
+			frontier.clear();
+			for(int i = 0; i < source_number; i++)
+			{
+				const int source = source_indices[i];
+				if(IsEmpty(visits[source])) frontier.push_back(source);
+				visits[source][i >> 6] |= std::uint64_t(1) << (i & 63);
+				seen[source][i >> 6] |= std::uint64_t(1) << (i & 63);
+			}
+			for(int vertex : frontier)
+			{
+				Visit(0, vertex, visits[vertex]);
+			}
+
+			for(int level = 1; !frontier.empty(); level++)
+			{
+				next_frontier.clear();
+				for(int vertex : frontier)
+				{
+					const Bits& visit = visits[vertex];
+					for(int i = offsets[vertex]; i < offsets[vertex + 1]; i++)
+					{
+						const int neighbor = neighbors[i];
+						const Bits& neighbor_seen = seen[neighbor];
+						Bits& next_visit = next_visits[neighbor];
+						std::uint64_t before = 0;
+						std::uint64_t added = 0;
+						for(int w = 0; w < WordNumber; w++)
+						{
+							const std::uint64_t bits = visit[w] & ~neighbor_seen[w];
+							before |= next_visit[w];
+							added |= bits;
+							next_visit[w] |= bits;
+						}
+						if(before == 0 && added != 0) next_frontier.push_back(neighbor);
+					}
+				}
+				for(int vertex : frontier)
+				{
+					visits[vertex] = Bits();
+				}
+
+				//seen is updated after the whole level, so every search of the level went through the old one
+				for(int vertex : next_frontier)
+				{
+					Bits& next_visit = next_visits[vertex];
+					for(int w = 0; w < WordNumber; w++)
+					{
+						seen[vertex][w] |= next_visit[w];
+					}
+					visits[vertex] = next_visit;
+					next_visit = Bits();
+					Visit(level, vertex, visits[vertex]);
+				}
+				frontier.swap(next_frontier);
+			}
+		}
+
+		/**	call Function(i) for each bit i of bits, from the smallest one
+		*/
+		template<typename FunctionT>
+		static void ForEachSource(const Bits& bits, FunctionT Function)
+		{
+			//de Bruijn sequence. the lowest bit times it has a distinct top 6 bits for each position
+			static const int positions[64] =
+			{
+				0, 1, 2, 53, 3, 7, 54, 27, 4, 38, 41, 8, 34, 55, 48, 28,
+				62, 5, 39, 46, 44, 42, 22, 9, 24, 35, 59, 56, 49, 18, 29, 11,
+				63, 52, 6, 26, 37, 40, 33, 47, 61, 45, 43, 21, 23, 58, 17, 10,
+				51, 25, 36, 32, 60, 20, 57, 16, 50, 31, 19, 15, 30, 14, 13, 12
+			};
+			for(int w = 0; w < WordNumber; w++)
+			{
+				for(std::uint64_t word = bits[w]; word != 0; word &= word - 1)
+				{
+					const std::uint64_t lowest = word & (~word + 1);
+					Function(64 * w + positions[(lowest * 0x022FDD63CC95386DULL) >> 58]);
+				}
+			}
+		}
+
+		static bool IsEmpty(const Bits& bits)
+		{
+			std::uint64_t any = 0;
+			for(int w = 0; w < WordNumber; w++)
+			{
+				any |= bits[w];
+			}
+			return any == 0;
+		}
+	};
+}
@@ -0,0 +1,273 @@
+#pragma once
+
+#include "AdjacencyMultiList.h"
+#include "CompressedGraph.h"
+#include "BreadthFirstSearch.h"
+#include "Ensemble.h"
+#include "ThreadPool.h"
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+namespace Network
+{
+	namespace AML = AdjacencyMultiList;
+
+	/**	closeness centrality of every vertex by hop distance, with the correction of Wasserman and Faust for disconnected graphs.
+	*	closeness of v = ((r - 1) / (N - 1)) * ((r - 1) / sum of distances from v), where r is the number of vertices v reaches, itself included.
+	*	it is same as the usual (N - 1) / sum of distances on a connected graph, and 0 for an isolated vertex.
+	*	the breadth first searches run in batches of 64 * WordNumber sources (MS-BFS), one batch per task of pool.
+	*@return	closeness of each vertex index
+	*@note	O(V * E / (64 * WordNumber)) on graphs of small diameter. must not be called by a task of the same pool.
+	*/
+	template<int WordNumber = 4, typename VT, typename ET, typename WeightT>
+	std::vector<double> ClosenessCentrality(const AML::CompressedGraph<VT, ET, WeightT>* target_graph, ThreadPool& pool);
+
+	/**	eccentricity of every vertex, the hop distance to the farthest vertex it reaches. MS-BFS from every vertex, like ClosenessCentrality.
+	*@return	eccentricity of each vertex index. vertices of other components are not counted, so an isolated vertex has 0
+	*/
+	template<int WordNumber = 4, typename VT, typename ET, typename WeightT>
+	std::vector<int> Eccentricities(const AML::CompressedGraph<VT, ET, WeightT>* target_graph, ThreadPool& pool);
+
+	/**	exact diameter, the biggest hop distance between two vertices of same component.
+	*	bounds of eccentricity (Takes and Kosters) : after a search from s, ecc(s) - d(s, v) <= ecc(v) <= ecc(s) + d(s, v) and d(s, v) <= ecc(v).
+	*	each round searches the vertices of biggest upper bound and smallest lower bound in MS-BFS batches, and drops every vertex
+	*	whose eccentricity is known or can't be bigger than the diameter found so far. real networks usually need a few rounds.
+	*@note	falls back to every eccentricity, O(V * E / (64 * WordNumber)), when the bounds don't help
+	*/
+	template<int WordNumber = 4, typename VT, typename ET, typename WeightT>
+	int Diameter(const AML::CompressedGraph<VT, ET, WeightT>* target_graph, ThreadPool& pool);
+
+	/**	lower bound of the diameter from a double sweep : eccentricities of source_number random vertices,
+	*	and of the farthest vertex each of them reaches.
+	*@param	source_number	64 * WordNumber fills one batch
+	*@param	seed			same seed gives same sources on every platform
+	*/
+	template<int WordNumber = 4, typename VT, typename ET, typename WeightT>
+	int ApproximateDiameter(const AML::CompressedGraph<VT, ET, WeightT>* target_graph, ThreadPool& pool, int source_number, std::uint64_t seed);
+
+	/**	ClosenessCentrality on the snapshot of given graph. the snapshot is built inside, O(V + E), and indices are the ones of vertex_list.
+	*/
+	template<int WordNumber = 4, typename VT, typename ET>
+	std::vector<double> ClosenessCentrality(AML::Graph<VT, ET>* target_graph, ThreadPool& pool)
+	{
+		AML::CompressedGraph<VT, ET> snapshot(target_graph, [](AML::Edge<VT, ET>*){ return 1.0f; });
+		return ClosenessCentrality<WordNumber>(&snapshot, pool);
+	}
+
+	template<int WordNumber = 4, typename VT, typename ET>
+	std::vector<int> Eccentricities(AML::Graph<VT, ET>* target_graph, ThreadPool& pool)
+	{
+		AML::CompressedGraph<VT, ET> snapshot(target_graph, [](AML::Edge<VT, ET>*){ return 1.0f; });
+		return Eccentricities<WordNumber>(&snapshot, pool);
+	}
+
+	template<int WordNumber = 4, typename VT, typename ET>
+	int Diameter(AML::Graph<VT, ET>* target_graph, ThreadPool& pool)
+	{
+		AML::CompressedGraph<VT, ET> snapshot(target_graph, [](AML::Edge<VT, ET>*){ return 1.0f; });
+		return Diameter<WordNumber>(&snapshot, pool);
+	}
+
+	template<int WordNumber = 4, typename VT, typename ET>
+	int ApproximateDiameter(AML::Graph<VT, ET>* target_graph, ThreadPool& pool, int source_number, std::uint64_t seed)
+	{
+		AML::CompressedGraph<VT, ET> snapshot(target_graph, [](AML::Edge<VT, ET>*){ return 1.0f; });
+		return ApproximateDiameter<WordNumber>(&snapshot, pool, source_number, seed);
+	}
+
+	/**	internal function of the MS-BFS measures. searches from sources in batches on the workers of pool, each worker reusing its buffers.
+	*	Visit is called as Visit(first, level, vertex_index, bits) on a worker, where bit i of bits is sources[first + i].
+	*	batches run at the same time, so Visit must write only the data of its own sources or its own batch.
+	*/
+	template<int WordNumber, typename VT, typename ET, typename WeightT, typename VisitT>
+	void _RunSourceBatches(const AML::CompressedGraph<VT, ET, WeightT>* target_graph, const std::vector<int>& sources, ThreadPool& pool, VisitT Visit)
+	{
+		typedef ShortestPath::MultiSourceBreadthFirstSearch<WordNumber> SearchT;
+		const int source_number = int(sources.size());
+		const int batch_number = (source_number + SearchT::batch_size - 1) / SearchT::batch_size;
+
+		RunWithWorkspaces<SearchT>(pool, batch_number, [&](int batch, SearchT& search)
+		{
+			const int first = batch * SearchT::batch_size;
+			const int count = std::min(int(SearchT::batch_size), source_number - first);
+			search.Run(target_graph, sources.data() + first, count, [&](int level, int vertex, const typename SearchT::Bits& bits)
+			{
+				Visit(first, level, vertex, bits);
+			});
+		});
+	}
+
+	/**	internal function of the MS-BFS measures. eccentricity of each source
+	*@param	farthest_return	if not nullptr, a vertex at the eccentricity of each source
+	*/
+	template<int WordNumber, typename VT, typename ET, typename WeightT>
+	std::vector<int> _Eccentricities(const AML::CompressedGraph<VT, ET, WeightT>* target_graph, const std::vector<int>& sources,
+									 ThreadPool& pool, std::vector<int>* farthest_return = nullptr)
+	{
+		typedef ShortestPath::MultiSourceBreadthFirstSearch<WordNumber> SearchT;
+		std::vector<int> eccentricities(sources.size(), 0);
+		if(farthest_return != nullptr) farthest_return->assign(sources.begin(), sources.end());
+
+		_RunSourceBatches<WordNumber>(target_graph, sources, pool, [&](int first, int level, int vertex, const typename SearchT::Bits& bits)
+		{
+			SearchT::ForEachSource(bits, [&](int i)
+			{
+				//levels come in order, so the last one is the eccentricity
+				eccentricities[first + i] = level;
+				if(farthest_return != nullptr) (*farthest_return)[first + i] = vertex;
+			});
+		});
+		return eccentricities;
+	}
+
+	template<int WordNumber, typename VT, typename ET, typename WeightT>
+	std::vector<double> ClosenessCentrality(const AML::CompressedGraph<VT, ET, WeightT>* target_graph, ThreadPool& pool)
+	{
+		typedef ShortestPath::MultiSourceBreadthFirstSearch<WordNumber> SearchT;
+		if(target_graph == nullptr) throw std::invalid_argument("target_graph == nullptr");
+
+		const int network_size = target_graph->GetVertexNumber();
+		std::vector<int> sources(network_size);
+		for(int i = 0; i < network_size; i++) sources[i] = i;
+
+		std::vector<long long> distance_sums(network_size, 0);
+		std::vector<int> reached_numbers(network_size, 0);
+		_RunSourceBatches<WordNumber>(target_graph, sources, pool, [&](int first, int level, int, const typename SearchT::Bits& bits)
+		{
+			SearchT::ForEachSource(bits, [&](int i)
+			{
+				distance_sums[first + i] += level;
+				++reached_numbers[first + i];
+			});
+		});
+
+		std::vector<double> closeness(network_size, 0.0);
+		for(int i = 0; i < network_size; i++)
+		{
+			if(distance_sums[i] == 0) continue;
+			const double others = double(reached_numbers[i] - 1);
+			closeness[i] = (others / (network_size - 1)) * (others / double(distance_sums[i]));
+		}
+		return closeness;
+	}
+
+	template<int WordNumber, typename VT, typename ET, typename WeightT>
+	std::vector<int> Eccentricities(const AML::CompressedGraph<VT, ET, WeightT>* target_graph, ThreadPool& pool)
+	{
+		if(target_graph == nullptr) throw std::invalid_argument("target_graph == nullptr");
+
+		std::vector<int> sources(target_graph->GetVertexNumber());
+		for(int i = 0; i < int(sources.size()); i++) sources[i] = i;
+		return _Eccentricities<WordNumber>(target_graph, sources, pool);
+	}
+
+	template<int WordNumber, typename VT, typename ET, typename WeightT>
+	int Diameter(const AML::CompressedGraph<VT, ET, WeightT>* target_graph, ThreadPool& pool)
+	{
+		typedef ShortestPath::MultiSourceBreadthFirstSearch<WordNumber> SearchT;
+		if(target_graph == nullptr) throw std::invalid_argument("target_graph == nullptr");
+
+		const int network_size = target_graph->GetVertexNumber();
+		const int round_size = SearchT::batch_size * pool.GetThreadNumber();
+		const int no_bound = std::numeric_limits<int>::max();
+
+		std::vector<int> lowers(network_size, 0);
+		std::vector<int> uppers(network_size, no_bound);
+		std::vector<int> candidates(network_size);
+		for(int i = 0; i < network_size; i++) candidates[i] = i;
+		int diameter = 0;
+
+		while(true)
+		{
+			candidates.erase(std::remove_if(candidates.begin(), candidates.end(), [&](int vertex)
+			{
+				return lowers[vertex] == uppers[vertex] || uppers[vertex] <= diameter;
+			}), candidates.end());
+			if(candidates.empty()) break;
+
+			//half of the round from the biggest upper bounds, and half from the smallest lower bounds. ties by smaller index
+			std::vector<int> sources;
+			if(int(candidates.size()) <= round_size)
+			{
+				sources = candidates;
+			}
+			else
+			{
+				const int half = round_size / 2;
+				std::nth_element(candidates.begin(), candidates.begin() + half, candidates.end(), [&](int x, int y)
+				{
+					return uppers[x] != uppers[y] ? uppers[x] > uppers[y] : x < y;
+				});
+				std::nth_element(candidates.begin() + half, candidates.begin() + round_size, candidates.end(), [&](int x, int y)
+				{
+					return lowers[x] != lowers[y] ? lowers[x] < lowers[y] : x < y;
+				});
+				sources.assign(candidates.begin(), candidates.begin() + round_size);
+			}
+
+			//eccentricities of the sources first, then the bounds of every vertex they reach. each batch keeps its own bounds
+			const std::vector<int> eccentricities = _Eccentricities<WordNumber>(target_graph, sources, pool);
+			const int batch_number = (int(sources.size()) + SearchT::batch_size - 1) / SearchT::batch_size;
+			std::vector<std::vector<int>> batch_lowers(batch_number, std::vector<int>(network_size, 0));
+			std::vector<std::vector<int>> batch_uppers(batch_number, std::vector<int>(network_size, no_bound));
+			_RunSourceBatches<WordNumber>(target_graph, sources, pool, [&](int first, int level, int vertex, const typename SearchT::Bits& bits)
+			{
+				int& lower = batch_lowers[first / SearchT::batch_size][vertex];
+				int& upper = batch_uppers[first / SearchT::batch_size][vertex];
+				SearchT::ForEachSource(bits, [&](int i)
+				{
+					const int eccentricity = eccentricities[first + i];
+					lower = std::max(lower, std::max(eccentricity - level, level));
+					upper = std::min(upper, eccentricity + level);
+				});
+			});
+
+			for(int vertex = 0; vertex < network_size; vertex++)
+			{
+				for(int batch = 0; batch < batch_number; batch++)
+				{
+					lowers[vertex] = std::max(lowers[vertex], batch_lowers[batch][vertex]);
+					uppers[vertex] = std::min(uppers[vertex], batch_uppers[batch][vertex]);
+				}
+				//every eccentricity is a lower bound of the diameter
+				diameter = std::max(diameter, lowers[vertex]);
+			}
+		}
+		return diameter;
+	}
+
+	template<int WordNumber, typename VT, typename ET, typename WeightT>
+	int ApproximateDiameter(const AML::CompressedGraph<VT, ET, WeightT>* target_graph, ThreadPool& pool, int source_number, std::uint64_t seed)
+	{
+		if(target_graph == nullptr) throw std::invalid_argument("target_graph == nullptr");
+		if(source_number <= 0) throw std::invalid_argument("source_number <= 0");
+
+		const int network_size = target_graph->GetVertexNumber();
+		if(network_size == 0) return 0;
+		source_number = std::min(source_number, network_size);
+
+		//first source_number of a Fisher-Yates shuffle
+		std::vector<int> order(network_size);
+		for(int i = 0; i < network_size; i++) order[i] = i;
+		CounterRandom random(seed);
+		for(int i = 0; i < source_number; i++)
+		{
+			std::swap(order[i], order[i + int(random() % std::uint64_t(network_size - i))]);
+		}
+		std::vector<int> sources(order.begin(), order.begin() + source_number);
+
+		std::vector<int> farthest;
+		std::vector<int> eccentricities = _Eccentricities<WordNumber>(target_graph, sources, pool, &farthest);
+		int diameter = *std::max_element(eccentricities.begin(), eccentricities.end());
+
+		//second sweep from the ends of the first one
+		std::sort(farthest.begin(), farthest.end());
+		farthest.erase(std::unique(farthest.begin(), farthest.end()), farthest.end());
+		eccentricities = _Eccentricities<WordNumber>(target_graph, farthest, pool);
+		diameter = std::max(diameter, *std::max_element(eccentricities.begin(), eccentricities.end()));
+		return diameter;
+	}
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "AdjacencyMultiList.h"
+
+namespace AdjacencyMultiList
+{
+	/**	Read-only snapshot of Graph in Compressed Sparse Row form.
+	*	neighbors of vertex i are stored in [offsets[i], offsets[i + 1]) of neighbors, edge_ids and weights.
+	*	vertex index is same as the index in vertex_list of the original graph, edge id is the index in edge_list.
+	*@tparam	VT	type of data witch will be stored inside vertex
+	*@tparam	ET	type of data witch will be stored inside edge
+	*@tparam	WeightT	type of weight kept in the snapshot
+	*@note		the snapshot is not updated when the original graph changes. build it again after modifying the graph.
+	*/
+	template<typename VT, typename ET, typename WeightT = float>
+	class CompressedGraph
+	{
+	public:
+		CompressedGraph(){}
+
+		/**@param	target_graph	graph to take snapshot of
+		*@param		GetEdgeWeight	The Fuction which get weight from the pointer of edge. called once per edge.
+		*/
+		template<typename WeightFunctionT>
+		CompressedGraph(Graph<VT, ET>* target_graph, WeightFunctionT GetEdgeWeight)
+		{
+			Build(target_graph, GetEdgeWeight);
+		}
+
+	public:
+		//size V + 1
+		std::vector<int> offsets;
+
+		//size 2E, opposite vertex index of each adjacency
+		std::vector<int> neighbors;
+
+		//size 2E, edge id of each adjacency
+		std::vector<int> edge_ids;
+
+		//size 2E, weight of each adjacency
+		std::vector<WeightT> weights;
+
+		//size E, weight of each edge id
+		std::vector<WeightT> edge_weights;
+
+		//size E, two vertex indices of each edge id
+		std::vector<std::array<int, 2>> edge_vertices;
+
+		std::vector<Vertex<VT, ET>*> vertex_list;
+
+		std::vector<Edge<VT, ET>*> edge_list;
+
+	public:
+		/**	take snapshot of given graph.
+		*@note	calls ResetVertexIndex of target_graph. O(V + E)
+		*/
+		template<typename WeightFunctionT>
+		void Build(Graph<VT, ET>* target_graph, WeightFunctionT GetEdgeWeight);
+
+		int GetVertexNumber() const { return int(vertex_list.size()); }
+
+		int GetEdgeNumber() const { return int(edge_list.size()); }
+
+		int GetDegree(int vertex_index) const { return offsets[vertex_index + 1] - offsets[vertex_index]; }
+
+		/**	check the vertex belongs to the graph this snapshot was taken from, and the index is still valid.
+		*/
+		bool Contains(Vertex<VT, ET>* vertex) const
+		{
+			if(vertex == nullptr) return false;
+			if(vertex->index < 0 || vertex->index >= GetVertexNumber()) return false;
+			return vertex_list[vertex->index] == vertex;
+		}
+	};
+
+	template<typename VT, typename ET, typename WeightT>
+	template<typename WeightFunctionT>
+	inline void CompressedGraph<VT, ET, WeightT>::Build(Graph<VT, ET>* target_graph, WeightFunctionT GetEdgeWeight)
+	{
+		if(target_graph == nullptr) throw std::invalid_argument("target_graph == nullptr");
+
+		target_graph->ResetVertexIndex();
+		vertex_list = target_graph->vertex_list;
+
+		const int network_size = int(vertex_list.size());
+		const int edge_number = target_graph->GetEdgeNumber();
+
+		offsets.assign(network_size + 1, 0);
+		for(int i = 0; i < network_size; i++)
+		{
+			offsets[i + 1] = offsets[i] + vertex_list[i]->GetDegree();
+		}
+
+		neighbors.assign(offsets[network_size], -1);
+		edge_ids.assign(offsets[network_size], -1);
+		weights.assign(offsets[network_size], WeightT());
+
+		edge_list.clear();
+		edge_list.reserve(edge_number);
+		edge_weights.clear();
+		edge_weights.reserve(edge_number);
+		edge_vertices.clear();
+		edge_vertices.reserve(edge_number);
+
+		std::vector<int> cursor(offsets.begin(), offsets.end() - 1);
+
+		//every edge is numbered once, from the list of its vertex[0]
+		for(int i = 0; i < network_size; i++)
+		{
+			Vertex<VT, ET>* vertex = vertex_list[i];
+			Edge<VT, ET>* current_edge = vertex->GetFront();
+			while(current_edge != nullptr)
+			{
+				if(current_edge->GetVertex(0) == vertex)
+				{
+					const int id = int(edge_list.size());
+					const int opposite = current_edge->GetOpposite(vertex)->index;
+					const WeightT weight = WeightT(GetEdgeWeight(current_edge));
+
+					edge_list.push_back(current_edge);
+					edge_weights.push_back(weight);
+					edge_vertices.push_back({{i, opposite}});
+
+					int slot = cursor[i]++;
+					neighbors[slot] = opposite;
+					edge_ids[slot] = id;
+					weights[slot] = weight;
+
+					slot = cursor[opposite]++;
+					neighbors[slot] = i;
+					edge_ids[slot] = id;
+					weights[slot] = weight;
+				}
+				current_edge = current_edge->GetNext(vertex);
+			}
+		}
+	}
+}
@@ -0,0 +1,289 @@
+#pragma once
+
+#include "AdjacencyMultiList.h"
+#include "CompressedGraph.h"
+#include "UnionFind.h"
+#include "ThreadPool.h"
+#include <vector>
+#include <random>
+#include <thread>
+#include <algorithm>
+#include <stdexcept>
+
+namespace Network
+{
+	namespace AML = AdjacencyMultiList;
+
+	/**	Connected components of a graph, kept in flat arrays.
+	*	found by Afforest : every vertex is linked to its first few neighbors on a concurrent union-find,
+	*	the largest component so far is guessed by sampling, and only the vertices outside of it look at the rest of their edges.
+	*@tparam	VT	type of data witch will be stored inside vertex
+	*@tparam	ET	type of data witch will be stored inside edge
+	*@note		components are numbered in the order of their smallest vertex index, so the result doesn't depend on thread_number.
+	*			the arrays are not updated when the original graph changes. build it again after modifying the graph.
+	*/
+	template<typename VT, typename ET>
+	class ConnectedComponents
+	{
+	public:
+		//vertex of each index
+		std::vector<AML::Vertex<VT, ET>*> vertex_list;
+
+		//component of each vertex index
+		std::vector<int> component_ids;
+
+		//number of vertices in each component
+		std::vector<int> component_sizes;
+
+	protected:
+		//vertex indices sorted by component, and where each component begins. built by the first call which needs them
+		mutable std::vector<int> member_offsets;
+		mutable std::vector<int> members;
+
+	public:
+		ConnectedComponents(){}
+
+		/**@param	thread_number	0 uses std::thread::hardware_concurrency()
+		*/
+		ConnectedComponents(AML::Graph<VT, ET>* target_graph, int thread_number = 0)
+		{
+			Build(target_graph, thread_number);
+		}
+
+		template<typename WeightT>
+		ConnectedComponents(const AML::CompressedGraph<VT, ET, WeightT>* target_graph, int thread_number = 0)
+		{
+			Build(target_graph, thread_number);
+		}
+
+		/**	find the components of graph. calls ResetVertexIndex of target_graph.
+		*@note	O((V + E) α(V)) work, spread over thread_number threads
+		*/
+		void Build(AML::Graph<VT, ET>* target_graph, int thread_number = 0);
+
+		/**	find the components of the Compressed Sparse Row snapshot of graph
+		*/
+		template<typename WeightT>
+		void Build(const AML::CompressedGraph<VT, ET, WeightT>* target_graph, int thread_number = 0);
+
+		int GetComponentNumber() const { return int(component_sizes.size()); }
+
+		int GetVertexNumber() const { return int(component_ids.size()); }
+
+		/**@return	component with the most vertices, the first one among same sizes. -1 if the graph is empty
+		*/
+		int GetLargestComponent() const
+		{
+			if(component_sizes.empty()) return -1;
+			return int(std::max_element(component_sizes.begin(), component_sizes.end()) - component_sizes.begin());
+		}
+
+		/**	vertices of given component, in the order of index.
+		*@note	the first call sorts every vertex by component in O(V). not thread safe until then
+		*/
+		std::vector<AML::Vertex<VT, ET>*> GetCluster(int component) const
+		{
+			if(component < 0 || component >= GetComponentNumber()) throw std::invalid_argument("component is out of range");
+			_BuildMembers();
+			std::vector<AML::Vertex<VT, ET>*> cluster;
+			cluster.reserve(component_sizes[component]);
+			for(int i = member_offsets[component]; i < member_offsets[component + 1]; i++)
+			{
+				cluster.push_back(vertex_list[members[i]]);
+			}
+			return cluster;
+		}
+
+		/**	every component as a vector of vertices, the form of FindClusters.
+		*/
+		void GetClusters(std::vector<std::vector<AML::Vertex<VT, ET>*>>& clusters_return) const
+		{
+			clusters_return.clear();
+			clusters_return.reserve(GetComponentNumber());
+			for(int i = 0; i < GetComponentNumber(); i++)
+			{
+				clusters_return.push_back(GetCluster(i));
+			}
+		}
+
+	protected:
+		/**	internal function of Build.
+		*	Neighbors is called as Neighbors(vertex, first, last, Function), and calls Function(neighbor) for the neighbors of vertex
+		*	from first th to before last th. last of -1 means the end.
+		*/
+		template<typename NeighborsT>
+		void _Afforest(int network_size, int thread_number, NeighborsT Neighbors);
+
+		void _BuildMembers() const;
+	};
+
+	template<typename VT, typename ET>
+	inline void ConnectedComponents<VT, ET>::Build(AML::Graph<VT, ET>* target_graph, int thread_number)
+	{
+		if(target_graph == nullptr) throw std::invalid_argument("target_graph == nullptr");
+
+		target_graph->ResetVertexIndex();
+		vertex_list = target_graph->vertex_list;
+		_Afforest(int(vertex_list.size()), thread_number, [this](int vertex, int first, int last, auto Function)
+		{
+			AML::Vertex<VT, ET>* current_vertex = vertex_list[vertex];
+			AML::Edge<VT, ET>* current_edge = current_vertex->GetFront();
+			for(int position = 0; current_edge != nullptr && position != last; position++)
+			{
+				if(position >= first) Function(current_edge->GetOpposite(current_vertex)->index);
+				current_edge = current_edge->GetNext(current_vertex);
+			}
+		});
+	}
+
+	template<typename VT, typename ET>
+	template<typename WeightT>
+	inline void ConnectedComponents<VT, ET>::Build(const AML::CompressedGraph<VT, ET, WeightT>* target_graph, int thread_number)
+	{
+		if(target_graph == nullptr) throw std::invalid_argument("target_graph == nullptr");
+
+		vertex_list = target_graph->vertex_list;
+		_Afforest(target_graph->GetVertexNumber(), thread_number, [target_graph](int vertex, int first, int last, auto Function)
+		{
+			const int begin = target_graph->offsets[vertex];
+			const int end = target_graph->offsets[vertex + 1];
+			const int stop = (last == -1 || begin + last > end) ? end : begin + last;
+			for(int i = begin + first; i < stop; i++)
+			{
+				Function(target_graph->neighbors[i]);
+			}
+		});
+	}
+
+	template<typename VT, typename ET>
+	template<typename NeighborsT>
+	inline void ConnectedComponents<VT, ET>::_Afforest(int network_size, int thread_number, NeighborsT Neighbors)
+	{
+		//neighbors linked before sampling
+		const int neighbor_rounds = 2;
+		const int sample_number = 1024;
+
+		if(thread_number <= 0) thread_number = int(std::thread::hardware_concurrency());
+		if(thread_number <= 0) thread_number = 1;
+		const int chunk_number = (network_size >= parallel_threshold) ? thread_number : 1;
+
+		member_offsets.clear();
+		members.clear();
+		component_ids.assign(network_size, -1);
+		component_sizes.clear();
+		if(network_size == 0) return;
+
+		//a link puts the root of bigger index under the other root, so the root of each set is its smallest vertex
+		ConcurrentUnionFindTree union_find_tree(network_size);
+		auto Compress = [&union_find_tree](int, int begin, int end)
+		{
+			for(int i = begin; i < end; i++)
+			{
+				union_find_tree.parents[i].store(union_find_tree.Find(i), std::memory_order_relaxed);
+			}
+		};
+
+		for(int round = 0; round < neighbor_rounds; round++)
+		{
+			ForEachChunk(chunk_number, network_size, [&](int, int begin, int end)
+			{
+				for(int i = begin; i < end; i++)
+				{
+					Neighbors(i, round, round + 1, [&union_find_tree, i](int neighbor){ union_find_tree.Union(i, neighbor); });
+				}
+			});
+			ForEachChunk(chunk_number, network_size, Compress);
+		}
+
+		//the most frequent root among samples is likely the giant component. its vertices skip the rest of their edges,
+		//because an edge from outside of it is still seen from the other end
+		std::minstd_rand generator(42);
+		std::uniform_int_distribution<int> vertex_dist(0, network_size - 1);
+		std::vector<int> sampled_roots(sample_number);
+		for(int& root : sampled_roots)
+		{
+			root = union_find_tree.parents[vertex_dist(generator)].load(std::memory_order_relaxed);
+		}
+		std::sort(sampled_roots.begin(), sampled_roots.end());
+		int frequent_root = sampled_roots[0];
+		int frequent_count = 0;
+		for(int i = 0; i < sample_number;)
+		{
+			int j = i;
+			while(j < sample_number && sampled_roots[j] == sampled_roots[i]) j++;
+			if(j - i > frequent_count)
+			{
+				frequent_root = sampled_roots[i];
+				frequent_count = j - i;
+			}
+			i = j;
+		}
+
+		ForEachChunk(chunk_number, network_size, [&](int, int begin, int end)
+		{
+			for(int i = begin; i < end; i++)
+			{
+				if(union_find_tree.Find(i) == frequent_root) continue;
+				Neighbors(i, neighbor_rounds, -1, [&union_find_tree, i](int neighbor){ union_find_tree.Union(i, neighbor); });
+			}
+		});
+		ForEachChunk(chunk_number, network_size, Compress);
+
+		//number the roots of each chunk after the roots of the chunks before it, then label every vertex by its root
+		std::vector<int> root_counts(chunk_number, 0);
+		ForEachChunk(chunk_number, network_size, [&](int chunk, int begin, int end)
+		{
+			int count = 0;
+			for(int i = begin; i < end; i++)
+			{
+				if(union_find_tree.parents[i].load(std::memory_order_relaxed) == i) component_ids[i] = count++;
+			}
+			root_counts[chunk] = count;
+		});
+		std::vector<int> root_offsets(chunk_number, 0);
+		for(int chunk = 1; chunk < chunk_number; chunk++)
+		{
+			root_offsets[chunk] = root_offsets[chunk - 1] + root_counts[chunk - 1];
+		}
+		ForEachChunk(chunk_number, network_size, [&](int chunk, int begin, int end)
+		{
+			for(int i = begin; i < end; i++)
+			{
+				if(component_ids[i] != -1) component_ids[i] += root_offsets[chunk];
+			}
+		});
+		ForEachChunk(chunk_number, network_size, [&](int, int begin, int end)
+		{
+			for(int i = begin; i < end; i++)
+			{
+				const int root = union_find_tree.parents[i].load(std::memory_order_relaxed);
+				if(root != i) component_ids[i] = component_ids[root];
+			}
+		});
+
+		component_sizes.assign(root_offsets[chunk_number - 1] + root_counts[chunk_number - 1], 0);
+		for(int component : component_ids)
+		{
+			++component_sizes[component];
+		}
+	}
+
+	template<typename VT, typename ET>
+	inline void ConnectedComponents<VT, ET>::_BuildMembers() const
+	{
+		if(int(member_offsets.size()) == GetComponentNumber() + 1) return;
+
+		//counting sort of vertices by component
+		member_offsets.assign(GetComponentNumber() + 1, 0);
+		for(int i = 0; i < GetComponentNumber(); i++)
+		{
+			member_offsets[i + 1] = member_offsets[i] + component_sizes[i];
+		}
+		std::vector<int> cursors(member_offsets.begin(), member_offsets.end() - 1);
+		members.resize(component_ids.size());
+		for(int i = 0; i < int(component_ids.size()); i++)
+		{
+			members[cursors[component_ids[i]]++] = i;
+		}
+	}
+}
@@ -0,0 +1,547 @@
+#pragma once
+
+#include "AdjacencyMultiList.h"
+#include "ShortestPath.h"
+#include <chrono>
+
+namespace ShortestPath
+{
+	namespace AML = AdjacencyMultiList;
+
+	/**	Contraction Hierarchies for repeated point-to-point shortest path queries on a fixed graph.
+	*	vertices are contracted one by one, in order of edge difference, and shortcut edges keep the distances of the remaining graph.
+	*	a query is bidirectional Dijkstra which only goes upward (to later contracted vertices) from both ends.
+	*	on scale-free graphs like BA network the remaining graph gets dense and each contraction costs more and more,
+	*	so contraction stops there and the remaining vertices are left as a core, which queries search by plain bidirectional Dijkstra.
+	*@tparam	VT	type of data witch will be stored inside vertex
+	*@tparam	ET	type of data witch will be stored inside edge
+	*@note		the hierarchy is not updated when the original graph changes. build it again after modifying the graph.
+	*			queries use the search buffers inside of the object, so one object can't be queried by several threads at once.
+	*/
+	template<typename VT, typename ET>
+	class ContractionHierarchy
+	{
+	protected:
+		struct Arc
+		{
+			int target;
+			float weight;
+			//contracted vertex which this shortcut bypasses. -1 for original edge
+			int middle;
+		};
+
+	public:
+		ContractionHierarchy(){}
+
+		/**@param	target_graph		graph to preprocess
+		*@param	GetEdgeWeight		The Fuction which get weight from the pointer of edge. weight must not be negative. kept as float.
+		*@param	witness_settle_limit	maximum settled vertices of one witness search. smaller value makes preprocessing faster but adds more shortcuts.
+		*@param	core_degree			contraction stops when mean degree of the remaining graph passes this. smaller value makes preprocessing faster
+		*								but leaves bigger core for queries. std::numeric_limits<float>::max() contracts every vertex.
+		*/
+		template<typename WeightFunctionT>
+		ContractionHierarchy(AML::Graph<VT, ET>* target_graph, WeightFunctionT GetEdgeWeight, int witness_settle_limit = 500, float core_degree = 12.0f)
+		{
+			Build(target_graph, GetEdgeWeight, witness_settle_limit, core_degree);
+		}
+
+	protected:
+		std::vector<AML::Vertex<VT, ET>*> vertex_list;
+
+		//contraction order of each vertex. vertices of the core have ranks from core_rank, in order of index
+		std::vector<int> ranks;
+		int core_rank = 0;
+
+		//arcs of vertex i to vertices with higher rank are in [up_offsets[i], up_offsets[i + 1]) of up_arcs.
+		//vertex of the core has the arcs to every other vertex of the core instead
+		std::vector<int> up_offsets;
+		std::vector<Arc> up_arcs;
+
+		int shortcut_number = 0;
+
+		long long preprocess_time = 0;
+
+		//marks of witness search targets, used while building
+		std::vector<unsigned int> target_mark;
+		unsigned int mark_stamp = 0;
+
+		//query buffers
+		SearchSpace<float> forward;
+		SearchSpace<float> backward;
+
+		//vertices of the core reached by upward search of each side, where the core search starts
+		std::vector<int> forward_entries;
+		std::vector<int> backward_entries;
+
+		//settled vertices of the last query
+		int settled_count = 0;
+
+	public:
+		/**	contract the vertices of given graph until the core is left. calls ResetVertexIndex of target_graph.
+		*/
+		template<typename WeightFunctionT>
+		void Build(AML::Graph<VT, ET>* target_graph, WeightFunctionT GetEdgeWeight, int witness_settle_limit = 500, float core_degree = 12.0f);
+
+		/**	shortest path by bidirectional upward search
+		*@return	same as DijkstraAlgorithmPath. vertices between start_vertex and end_vertex, empty if not reachable.
+		*/
+		std::vector<AML::Vertex<VT, ET>*> FindPath(AML::Vertex<VT, ET>* start_vertex, AML::Vertex<VT, ET>* end_vertex);
+
+		/**	length of shortest path by bidirectional upward search
+		*@return	std::numeric_limits<float>::max() if not reachable
+		*/
+		float FindDistance(AML::Vertex<VT, ET>* start_vertex, AML::Vertex<VT, ET>* end_vertex);
+
+		bool Contains(AML::Vertex<VT, ET>* vertex) const
+		{
+			if(vertex == nullptr) return false;
+			if(vertex->index < 0 || vertex->index >= int(vertex_list.size())) return false;
+			return vertex_list[vertex->index] == vertex;
+		}
+
+		int GetShortcutNumber() const { return shortcut_number; }
+
+		//number of vertices left uncontracted in the core
+		int GetCoreNumber() const { return int(ranks.size()) - core_rank; }
+
+		//preprocessing time in milliseconds
+		long long GetPreprocessTime() const { return preprocess_time; }
+
+		//bytes used by the query structure
+		std::size_t GetMemoryUsage() const
+		{
+			return vertex_list.capacity() * sizeof(AML::Vertex<VT, ET>*)
+				+ ranks.capacity() * sizeof(int)
+				+ up_offsets.capacity() * sizeof(int)
+				+ up_arcs.capacity() * sizeof(Arc);
+		}
+
+		int GetSettledCount() const { return settled_count; }
+
+	protected:
+		/**	internal function of Build. contract (or simulate contracting) vertex,
+		*	by adding a shortcut between every two neighbors which has no shorter witness path avoiding the vertex.
+		*@return	number of new arcs needed. a shortcut which only lowers the weight of an existing arc is not counted
+		*/
+		int _Contract(int vertex, bool simulate, std::vector<std::vector<Arc>>& adjacency, SearchSpace<float>& witness, int witness_settle_limit);
+
+		/**	internal function of Build. add arc or lower the weight of existing arc from source to target
+		*@return	true if a new arc is added
+		*/
+		static bool _AddArc(std::vector<Arc>& arcs, int target, float weight, int middle);
+
+		//internal function of Build. true if arcs has an arc to target
+		static bool _HasArc(const std::vector<Arc>& arcs, int target);
+
+		//internal function of queries. upward search from both ends, then bidirectional Dijkstra in the core from where they entered it.
+		//returns meeting vertex or -1
+		int _Search(int start_index, int end_index, float& distance);
+
+		//internal function of _Search. bidirectional Dijkstra in the core, lowering distance and meeting_index of the path found
+		void _CoreSearch(float& distance, int& meeting_index);
+
+		//internal function of FindPath. the arc between two vertices, stored in the list of lower ranked one
+		const Arc* _FindArc(int vertex0, int vertex1) const;
+	};
+
+	template<typename VT, typename ET>
+	inline bool ContractionHierarchy<VT, ET>::_AddArc(std::vector<Arc>& arcs, int target, float weight, int middle)
+	{
+		for(Arc& arc : arcs)
+		{
+			if(arc.target == target)
+			{
+				if(weight < arc.weight)
+				{
+					arc.weight = weight;
+					arc.middle = middle;
+				}
+				return false;
+			}
+		}
+		arcs.push_back(Arc{target, weight, middle});
+		return true;
+	}
+
+	template<typename VT, typename ET>
+	inline bool ContractionHierarchy<VT, ET>::_HasArc(const std::vector<Arc>& arcs, int target)
+	{
+		for(const Arc& arc : arcs)
+		{
+			if(arc.target == target) return true;
+		}
+		return false;
+	}
+
+	template<typename VT, typename ET>
+	inline int ContractionHierarchy<VT, ET>::_Contract(int vertex, bool simulate, std::vector<std::vector<Arc>>& adjacency, SearchSpace<float>& witness, int witness_settle_limit)
+	{
+		//arcs to contracted vertices are already removed from the remaining graph.
+		//shortcuts are added only between the neighbors, so this list is not changed while contracting
+		const std::vector<Arc>& neighbors = adjacency[vertex];
+
+		int shortcut_count = 0;
+		for(std::size_t i = 0; i + 1 < neighbors.size(); i++)
+		{
+			const int source = neighbors[i].target;
+			++mark_stamp;
+			for(std::size_t j = i + 1; j < neighbors.size(); j++)
+			{
+				target_mark[neighbors[j].target] = mark_stamp;
+			}
+			float max_distance = 0.0f;
+			for(std::size_t j = i + 1; j < neighbors.size(); j++)
+			{
+				max_distance = std::max(max_distance, neighbors[i].weight + neighbors[j].weight);
+			}
+
+			//witness search from source on the remaining graph without vertex.
+			//stops when every target is settled, or the limits are reached
+			witness.Reset();
+			witness.Start(source, 0.0f);
+			int settled = 0;
+			int remaining_targets = int(neighbors.size() - i - 1);
+			while(!witness.heap.Empty() && settled < witness_settle_limit && remaining_targets > 0)
+			{
+				if(witness.heap.TopKey() > max_distance) break;
+				int current = witness.Settle();
+				++settled;
+				if(target_mark[current] == mark_stamp) --remaining_targets;
+				const float current_distance = witness.distances[current];
+				for(const Arc& arc : adjacency[current])
+				{
+					if(arc.target == vertex) continue;
+					witness.Relax(arc.target, current_distance + arc.weight, current);
+				}
+			}
+
+			for(std::size_t j = i + 1; j < neighbors.size(); j++)
+			{
+				const int target = neighbors[j].target;
+				const float via_distance = neighbors[i].weight + neighbors[j].weight;
+				if(witness.GetDistance(target) <= via_distance) continue;
+
+				//arcs are kept in both directions, so the reverse arc is new exactly when the forward one is
+				if(simulate)
+				{
+					if(!_HasArc(adjacency[source], target)) ++shortcut_count;
+				}
+				else
+				{
+					if(_AddArc(adjacency[source], target, via_distance, vertex)) ++shortcut_count;
+					_AddArc(adjacency[target], source, via_distance, vertex);
+				}
+			}
+		}
+		return shortcut_count;
+	}
+
+	template<typename VT, typename ET>
+	template<typename WeightFunctionT>
+	inline void ContractionHierarchy<VT, ET>::Build(AML::Graph<VT, ET>* target_graph, WeightFunctionT GetEdgeWeight, int witness_settle_limit,
+													float core_degree)
+	{
+		if(target_graph == nullptr) throw std::invalid_argument("target_graph == nullptr");
+		if(!(core_degree >= 0.0f)) throw std::invalid_argument("core_degree < 0");
+
+		std::chrono::time_point<std::chrono::high_resolution_clock> start_point
+			= std::chrono::high_resolution_clock::now();
+
+		target_graph->ResetVertexIndex();
+		vertex_list = target_graph->vertex_list;
+		const int network_size = int(vertex_list.size());
+
+		//remaining graph. original multi-edges are merged into the lightest one.
+		std::vector<std::vector<Arc>> adjacency(network_size);
+		for(int i = 0; i < network_size; i++)
+		{
+			AML::Vertex<VT, ET>* vertex = vertex_list[i];
+			adjacency[i].reserve(vertex->GetDegree());
+			AML::Edge<VT, ET>* current_edge = vertex->GetFront();
+			while(current_edge != nullptr)
+			{
+				_AddArc(adjacency[i], current_edge->GetOpposite(vertex)->index, float(GetEdgeWeight(current_edge)), -1);
+				current_edge = current_edge->GetNext(vertex);
+			}
+		}
+
+		std::vector<int> contracted_neighbors(network_size, 0);
+		std::vector<bool> outdated(network_size, false);
+		std::vector<std::vector<Arc>> upward(network_size);
+		ranks.assign(network_size, -1);
+		shortcut_number = 0;
+
+		SearchSpace<float> witness(network_size);
+		target_mark.assign(network_size, 0);
+		mark_stamp = 0;
+
+		//witness searches of priority estimation are shorter than the ones of real contraction
+		const int simulate_settle_limit = std::max(1, witness_settle_limit / 10);
+
+		//priority = edge difference + number of contracted neighbors. smaller is contracted first
+		auto GetPriority = [&](int vertex)->int
+		{
+			int shortcut_count = _Contract(vertex, true, adjacency, witness, simulate_settle_limit);
+			return shortcut_count - int(adjacency[vertex].size()) + contracted_neighbors[vertex];
+		};
+
+		IndexedHeap<int> order_heap(network_size);
+		for(int i = 0; i < network_size; i++)
+		{
+			order_heap.Push(i, GetPriority(i));
+		}
+
+		//arcs of the remaining graph, counted in both directions
+		long long remaining_arcs = 0;
+		for(const std::vector<Arc>& arcs : adjacency)
+		{
+			remaining_arcs += arcs.size();
+		}
+
+		int current_rank = 0;
+		while(!order_heap.Empty())
+		{
+			if(double(remaining_arcs) > double(core_degree) * (network_size - current_rank)) break;
+
+			//lazy update. priority may have grown since the neighbors were contracted
+			int vertex = order_heap.Pop();
+			if(outdated[vertex])
+			{
+				outdated[vertex] = false;
+				int priority = GetPriority(vertex);
+				if(!order_heap.Empty() && priority > order_heap.TopKey())
+				{
+					order_heap.Push(vertex, priority);
+					continue;
+				}
+			}
+
+			const int added_number = _Contract(vertex, false, adjacency, witness, witness_settle_limit);
+			shortcut_number += added_number;
+			remaining_arcs += 2LL * (added_number - (long long)adjacency[vertex].size());
+
+			for(const Arc& arc : adjacency[vertex])
+			{
+				upward[vertex].push_back(arc);
+				++contracted_neighbors[arc.target];
+				outdated[arc.target] = true;
+
+				//remaining graph doesn't need the arc back to contracted vertex any more
+				std::vector<Arc>& opposite_arcs = adjacency[arc.target];
+				for(std::size_t i = 0; i < opposite_arcs.size(); i++)
+				{
+					if(opposite_arcs[i].target == vertex)
+					{
+						opposite_arcs[i] = opposite_arcs.back();
+						opposite_arcs.pop_back();
+						break;
+					}
+				}
+			}
+			ranks[vertex] = current_rank++;
+			std::vector<Arc>().swap(adjacency[vertex]);
+		}
+		std::vector<unsigned int>().swap(target_mark);
+
+		//vertices left are the core. the arcs between them go to both ends
+		core_rank = current_rank;
+		for(int i = 0; i < network_size; i++)
+		{
+			if(ranks[i] != -1) continue;
+			ranks[i] = current_rank++;
+			upward[i].swap(adjacency[i]);
+		}
+
+		up_offsets.assign(network_size + 1, 0);
+		for(int i = 0; i < network_size; i++)
+		{
+			up_offsets[i + 1] = up_offsets[i] + int(upward[i].size());
+		}
+		up_arcs.clear();
+		up_arcs.reserve(up_offsets[network_size]);
+		for(int i = 0; i < network_size; i++)
+		{
+			up_arcs.insert(up_arcs.end(), upward[i].begin(), upward[i].end());
+		}
+
+		forward.Initialize(network_size);
+		backward.Initialize(network_size);
+
+		std::chrono::time_point<std::chrono::high_resolution_clock> end_point
+			= std::chrono::high_resolution_clock::now();
+		preprocess_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_point - start_point).count();
+	}
+
+	template<typename VT, typename ET>
+	inline int ContractionHierarchy<VT, ET>::_Search(int start_index, int end_index, float& distance)
+	{
+		forward.Reset();
+		backward.Reset();
+		forward_entries.clear();
+		backward_entries.clear();
+		forward.Start(start_index, 0.0f);
+		backward.Start(end_index, 0.0f);
+
+		distance = std::numeric_limits<float>::max();
+		int meeting_index = -1;
+
+		while(!forward.heap.Empty() || !backward.heap.Empty())
+		{
+			//expand the side with smaller top key. stop when both are not smaller than the path found
+			bool is_forward;
+			if(forward.heap.Empty()) is_forward = false;
+			else if(backward.heap.Empty()) is_forward = true;
+			else is_forward = forward.heap.TopKey() <= backward.heap.TopKey();
+
+			SearchSpace<float>& current_search = is_forward ? forward : backward;
+			SearchSpace<float>& other_search = is_forward ? backward : forward;
+
+			if(current_search.heap.TopKey() >= distance) break;
+
+			int current = current_search.Settle();
+			const float current_distance = current_search.distances[current];
+			if(other_search.IsReached(current) && current_distance + other_search.distances[current] < distance)
+			{
+				distance = current_distance + other_search.distances[current];
+				meeting_index = current;
+			}
+
+			//the core is not expanded upward
+			if(ranks[current] >= core_rank)
+			{
+				(is_forward ? forward_entries : backward_entries).push_back(current);
+				continue;
+			}
+
+			for(int i = up_offsets[current]; i < up_offsets[current + 1]; i++)
+			{
+				current_search.Relax(up_arcs[i].target, current_distance + up_arcs[i].weight, current);
+			}
+		}
+
+		if(GetCoreNumber() > 0) _CoreSearch(distance, meeting_index);
+
+		settled_count = int(forward.settled.size() + backward.settled.size());
+		return meeting_index;
+	}
+
+	template<typename VT, typename ET>
+	inline void ContractionHierarchy<VT, ET>::_CoreSearch(float& distance, int& meeting_index)
+	{
+		//vertices left in the heaps are not shorter than the path found, and only the ones of the core are kept as entries.
+		//their distances may still be lowered through the core, as they are back in the heaps
+		std::vector<int>* entries[2] = {&forward_entries, &backward_entries};
+		SearchSpace<float>* searches[2] = {&forward, &backward};
+		for(int side = 0; side < 2; side++)
+		{
+			SearchSpace<float>& search = *searches[side];
+			while(!search.heap.Empty())
+			{
+				const int vertex = search.heap.Pop();
+				if(ranks[vertex] >= core_rank) entries[side]->push_back(vertex);
+			}
+			for(int vertex : *entries[side])
+			{
+				search.heap.Push(vertex, search.distances[vertex]);
+			}
+		}
+
+		for(int vertex : forward_entries)
+		{
+			if(backward.IsReached(vertex) && forward.distances[vertex] + backward.distances[vertex] < distance)
+			{
+				distance = forward.distances[vertex] + backward.distances[vertex];
+				meeting_index = vertex;
+			}
+		}
+
+		//searches of the core are not upward, so it stops by the sum of top keys, as BidirectionalDijkstraPath
+		while(!forward.heap.Empty() && !backward.heap.Empty())
+		{
+			if(forward.heap.TopKey() + backward.heap.TopKey() >= distance) break;
+
+			const bool is_forward = forward.heap.Size() <= backward.heap.Size();
+			SearchSpace<float>& current_search = is_forward ? forward : backward;
+			SearchSpace<float>& other_search = is_forward ? backward : forward;
+
+			int current = current_search.Settle();
+			const float current_distance = current_search.distances[current];
+			for(int i = up_offsets[current]; i < up_offsets[current + 1]; i++)
+			{
+				const int target = up_arcs[i].target;
+				current_search.Relax(target, current_distance + up_arcs[i].weight, current);
+				if(other_search.IsReached(target) && current_search.distances[target] + other_search.distances[target] < distance)
+				{
+					distance = current_search.distances[target] + other_search.distances[target];
+					meeting_index = target;
+				}
+			}
+		}
+	}
+
+	template<typename VT, typename ET>
+	inline const typename ContractionHierarchy<VT, ET>::Arc* ContractionHierarchy<VT, ET>::_FindArc(int vertex0, int vertex1) const
+	{
+		int lower = (ranks[vertex0] < ranks[vertex1]) ? vertex0 : vertex1;
+		int higher = (lower == vertex0) ? vertex1 : vertex0;
+		for(int i = up_offsets[lower]; i < up_offsets[lower + 1]; i++)
+		{
+			if(up_arcs[i].target == higher) return &up_arcs[i];
+		}
+		return nullptr;
+	}
+
+	template<typename VT, typename ET>
+	inline float ContractionHierarchy<VT, ET>::FindDistance(AML::Vertex<VT, ET>* start_vertex, AML::Vertex<VT, ET>* end_vertex)
+	{
+		if(!Contains(start_vertex) || !Contains(end_vertex)) return std::numeric_limits<float>::max();
+		float distance;
+		_Search(start_vertex->index, end_vertex->index, distance);
+		return distance;
+	}
+
+	template<typename VT, typename ET>
+	inline std::vector<AML::Vertex<VT, ET>*> ContractionHierarchy<VT, ET>::FindPath(AML::Vertex<VT, ET>* start_vertex, AML::Vertex<VT, ET>* end_vertex)
+	{
+		std::vector<AML::Vertex<VT, ET>*> result;
+		if(!Contains(start_vertex) || !Contains(end_vertex)) return result;
+		if(start_vertex == end_vertex) return result;
+
+		float distance;
+		int meeting_index = _Search(start_vertex->index, end_vertex->index, distance);
+		if(meeting_index == -1) return result;
+
+		//path in the hierarchy : start ... meeting vertex ... end
+		std::vector<int> hierarchy_path = forward.GetPath(meeting_index);
+		hierarchy_path.insert(hierarchy_path.begin(), start_vertex->index);
+		if(meeting_index != start_vertex->index) hierarchy_path.push_back(meeting_index);
+		std::vector<int> backward_path = backward.GetPath(meeting_index);
+		hierarchy_path.insert(hierarchy_path.end(), backward_path.rbegin(), backward_path.rend());
+		if(meeting_index != end_vertex->index) hierarchy_path.push_back(end_vertex->index);
+
+		//unpack shortcuts into the original vertices
+		std::vector<std::pair<int, int>> segment_stack;
+		for(std::size_t i = 0; i + 1 < hierarchy_path.size(); i++)
+		{
+			segment_stack.emplace_back(hierarchy_path[i], hierarchy_path[i + 1]);
+			while(!segment_stack.empty())
+			{
+				std::pair<int, int> segment = segment_stack.back();
+				segment_stack.pop_back();
+				const Arc* arc = _FindArc(segment.first, segment.second);
+				if(arc == nullptr || arc->middle == -1)
+				{
+					result.push_back(vertex_list[segment.second]);
+				}
+				else
+				{
+					segment_stack.emplace_back(arc->middle, segment.second);
+					segment_stack.emplace_back(segment.first, arc->middle);
+				}
+			}
+		}
+		//last element is end_vertex
+		result.pop_back();
+		return result;
+	}
+}
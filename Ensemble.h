@@ -0,0 +1,145 @@
+#pragma once
+
+#include "AdjacencyMultiList.h"
+#include "Network.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <memory>
+#include <iterator>
+#include <type_traits>
+
+namespace Network
+{
+	namespace AML = AdjacencyMultiList;
+
+	/**	Counter-based random number engine. the n-th number of a stream is a hash of (key, n), so streams of different
+	*	replicates are independent and every replicate gets same numbers whatever thread runs it.
+	*	satisfies UniformRandomBitGenerator, so it can be passed to the distributions of <random>.
+	*/
+	class CounterRandom
+	{
+	public:
+		typedef std::uint64_t result_type;
+
+		/**@param	seed	seed of the whole ensemble
+		*@param	stream	index of the stream, the replicate index for RunEnsemble
+		*/
+		CounterRandom(std::uint64_t seed = 0, std::uint64_t stream = 0)
+			: key(Mix(seed ^ Mix(stream + golden_gamma))){}
+
+		static constexpr result_type min() { return 0; }
+
+		static constexpr result_type max() { return ~result_type(0); }
+
+		result_type operator()()
+		{
+			return Mix(key + (++counter) * golden_gamma);
+		}
+
+		//32 bit seed for the generators of Network.h
+		unsigned int Seed()
+		{
+			return (unsigned int)(operator()() >> 32);
+		}
+
+		//numbers drawn so far
+		std::uint64_t GetCounter() const { return counter; }
+
+	protected:
+		static const std::uint64_t golden_gamma = 0x9E3779B97F4A7C15ULL;
+
+		//finalizer of SplitMix64
+		static std::uint64_t Mix(std::uint64_t value)
+		{
+			value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+			return value ^ (value >> 31);
+		}
+
+		std::uint64_t key;
+		std::uint64_t counter = 0;
+	};
+
+	/**	generator of RunEnsemble which connects a Barabasi-Albert Network
+	*/
+	struct BAGenerator
+	{
+		int connection_per_step;
+
+		template<typename VT, typename ET>
+		void operator()(AML::Graph<VT, ET>* network, CounterRandom& random) const
+		{
+			Network::ConnectBANetwork(network, connection_per_step, random.Seed());
+		}
+	};
+
+	/**	generator of RunEnsemble which connects a G(n, p) ER Network of given mean degree
+	*/
+	struct ERGenerator
+	{
+		double mean_degree;
+
+		template<typename VT, typename ET>
+		void operator()(AML::Graph<VT, ET>* network, CounterRandom& random) const
+		{
+			const double size = double(network->vertex_list.size());
+			const double probability = (size < 2) ? 0.0 : std::min(1.0, mean_degree / (size - 1));
+			//replicates are run in parallel already
+			Network::ConnectGNPNetwork(network, probability, random.Seed(), 1);
+		}
+	};
+
+	/**	generator of RunEnsemble which makes a x by y lattice. random is not used
+	*/
+	struct LatticeGenerator
+	{
+		int x;
+		int y;
+
+		template<typename VT, typename ET>
+		void operator()(AML::Graph<VT, ET>* network, CounterRandom&) const
+		{
+			Network::InitializeLatticeNetwork(network, x, y);
+		}
+	};
+
+	/**	Run replicates of a random network experiment on the workers of pool.
+	*	each worker keeps one Graph and reuses it for every replicate it runs. the graph is initialized with network_size vertices
+	*	before each replicate, and its vertices and edges come from the object pools of the graph after the first replicate.
+	*@param	Generate	called as Generate(network, random). makes the network of the replicate. BAGenerator, ERGenerator, LatticeGenerator or a custom one
+	*@param	Measure		called as Measure(network, random) after Generate, with the same random. the value it returns is the result of the replicate
+	*@param	seed		replicate i draws from CounterRandom(seed, i)
+	*@return	results in the order of replicates. reduce them in this order, and the ensemble average is same bit for bit for any number of workers
+	*@note	blocks until every replicate is finished, and rethrows the first exception of them. must not be called by a task of the same pool.
+	*/
+	template<typename VT = int, typename ET = float, typename GeneratorT, typename MeasureT>
+	auto RunEnsemble(ThreadPool& pool, int network_size, int replicate_number, std::uint64_t seed, GeneratorT Generate, MeasureT Measure)
+		-> std::vector<typename std::decay<decltype(Measure(std::declval<AML::Graph<VT, ET>*>(), std::declval<CounterRandom&>()))>::type>;
+}
+
+template<typename VT, typename ET, typename GeneratorT, typename MeasureT>
+auto Network::RunEnsemble(ThreadPool& pool, int network_size, int replicate_number, std::uint64_t seed, GeneratorT Generate, MeasureT Measure)
+	-> std::vector<typename std::decay<decltype(Measure(std::declval<AML::Graph<VT, ET>*>(), std::declval<CounterRandom&>()))>::type>
+{
+	typedef typename std::decay<decltype(Measure(std::declval<AML::Graph<VT, ET>*>(), std::declval<CounterRandom&>()))>::type ResultT;
+
+	if(network_size < 0) throw std::invalid_argument("network_size < 0");
+	if(replicate_number < 0) throw std::invalid_argument("replicate_number < 0");
+
+	//each replicate writes only its own slot, so results are gathered without lock.
+	//std::vector<bool> packs the slots into shared words, so bool results are gathered as char
+	typedef typename std::conditional<std::is_same<ResultT, bool>::value, char, ResultT>::type SlotT;
+	std::vector<SlotT> results(replicate_number);
+	//the workspace of each worker is its graph, made by the first replicate it runs
+	RunWithWorkspaces<std::unique_ptr<AML::Graph<VT, ET>>>(pool, replicate_number, [&](int i, std::unique_ptr<AML::Graph<VT, ET>>& network)
+	{
+		if(!network) network.reset(new AML::Graph<VT, ET>(network_size));
+		//fresh vertices every replicate. their memory comes back from the pool of the graph
+		network->Initialize(network_size);
+		CounterRandom random(seed, std::uint64_t(i));
+		Generate(network.get(), random);
+		results[i] = Measure(network.get(), random);
+	});
+
+	return std::vector<ResultT>(std::make_move_iterator(results.begin()), std::make_move_iterator(results.end()));
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+
+/**	d-ary min heap of integer items with decrease-key.
+*	each item is an index in [0, capacity) and can be in the heap only once.
+*	position of every item is kept, so DecreaseKey and Contains are done without search.
+*@tparam	KeyT	type of key. items with smaller key come first, ties are broken by smaller index.
+*@tparam	Arity	number of children of each node
+*@note		time complexity : Push, DecreaseKey O(log_d(N)), Pop O(d log_d(N)). space : O(capacity)
+*/
+template<typename KeyT, int Arity = 4>
+class IndexedHeap
+{
+protected:
+	//(key, item) pairs in heap order
+	std::vector<std::pair<KeyT, int>> heap;
+
+	//position of each item inside heap. -1 if the item is not in the heap.
+	std::vector<int> positions;
+
+public:
+	IndexedHeap(){}
+
+	IndexedHeap(int capacity)
+	{
+		Initialize(capacity);
+	}
+
+	/**	remove every item and set the range of items to [0, capacity)
+	*/
+	void Initialize(int capacity)
+	{
+		heap.clear();
+		positions.assign(capacity > 0 ? capacity : 0, -1);
+	}
+
+	/**	remove every item. O(size of heap), not O(capacity).
+	*/
+	void Clear()
+	{
+		for(const std::pair<KeyT, int>& node : heap)
+		{
+			positions[node.second] = -1;
+		}
+		heap.clear();
+	}
+
+	int GetCapacity() const { return int(positions.size()); }
+
+	int Size() const { return int(heap.size()); }
+
+	bool Empty() const { return heap.empty(); }
+
+	bool Contains(int item) const { return positions[item] >= 0; }
+
+	int Top() const { return heap.front().second; }
+
+	KeyT TopKey() const { return heap.front().first; }
+
+	KeyT GetKey(int item) const { return heap[positions[item]].first; }
+
+	/**	insert item which is not in the heap
+	*/
+	void Push(int item, KeyT key)
+	{
+		heap.emplace_back(key, item);
+		positions[item] = int(heap.size()) - 1;
+		SiftUp(int(heap.size()) - 1);
+	}
+
+	/**	lower the key of item already in the heap
+	*/
+	void DecreaseKey(int item, KeyT key)
+	{
+		int position = positions[item];
+		heap[position].first = key;
+		SiftUp(position);
+	}
+
+	/**	insert item, or lower its key if it is already in the heap.
+	*@return	false if the item was in the heap with a key not bigger than given key
+	*/
+	bool PushOrDecrease(int item, KeyT key)
+	{
+		if(positions[item] < 0)
+		{
+			Push(item, key);
+			return true;
+		}
+		if(!(key < heap[positions[item]].first)) return false;
+		DecreaseKey(item, key);
+		return true;
+	}
+
+	/**	remove the item with smallest key
+	*@return	removed item
+	*/
+	int Pop()
+	{
+		int top_item = heap.front().second;
+		positions[top_item] = -1;
+		if(heap.size() > 1)
+		{
+			heap.front() = heap.back();
+			heap.pop_back();
+			positions[heap.front().second] = 0;
+			SiftDown(0);
+		}
+		else
+		{
+			heap.pop_back();
+		}
+		return top_item;
+	}
+
+protected:
+	static bool Less(const std::pair<KeyT, int>& front, const std::pair<KeyT, int>& back)
+	{
+		if(front.first < back.first) return true;
+		if(back.first < front.first) return false;
+		return front.second < back.second;
+	}
+
+	void SiftUp(int position)
+	{
+		std::pair<KeyT, int> node = heap[position];
+		while(position > 0)
+		{
+			int parent = (position - 1) / Arity;
+			if(!Less(node, heap[parent])) break;
+			heap[position] = heap[parent];
+			positions[heap[position].second] = position;
+			position = parent;
+		}
+		heap[position] = node;
+		positions[node.second] = position;
+	}
+
+	void SiftDown(int position)
+	{
+		const int size = int(heap.size());
+		std::pair<KeyT, int> node = heap[position];
+		while(true)
+		{
+			int first_child = position * Arity + 1;
+			if(first_child >= size) break;
+			int last_child = (first_child + Arity < size) ? first_child + Arity : size;
+			int smallest = first_child;
+			for(int child = first_child + 1; child < last_child; child++)
+			{
+				if(Less(heap[child], heap[smallest])) smallest = child;
+			}
+			if(!Less(heap[smallest], node)) break;
+			heap[position] = heap[smallest];
+			positions[heap[position].second] = position;
+			position = smallest;
+		}
+		heap[position] = node;
+		positions[node.second] = position;
+	}
+};
@@ -0,0 +1,222 @@
+#pragma once
+
+#include "AdjacencyMultiList.h"
+#include "CompressedGraph.h"
+#include "ShortestPath.h"
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+namespace ShortestPath
+{
+	namespace AML = AdjacencyMultiList;
+
+	/**	Landmark distance tables for ALT (A*, Landmarks, Triangle inequality) heuristic.
+	*	shortest distances from a few landmark vertices to every vertex are computed once,
+	*	then |d(L, end) - d(L, v)| is a lower bound of d(v, end) for every landmark L.
+	*	so the object can be passed as the heuristic of AStarAlgorithm on graphs without coordinates.
+	*@tparam	VT	type of data witch will be stored inside vertex
+	*@tparam	ET	type of data witch will be stored inside edge
+	*@note		the tables are not updated when the original graph changes. build it again after modifying the graph.
+	*			the heuristic is consistent, so it can be used by BidirectionalAStarAlgorithm too.
+	*/
+	template<typename VT, typename ET>
+	class Landmarks
+	{
+	public:
+		enum class Selection
+		{
+			//each landmark is the vertex farthest from the landmarks already chosen
+			Farthest,
+			//vertices with the biggest degree
+			Degree
+		};
+
+		Landmarks(){}
+
+		/**@param	target_graph		graph to preprocess
+		*@param	GetEdgeWeight		The Fuction which get weight from the pointer of edge. weight must not be negative. kept as float.
+		*@param	landmark_number		number of landmarks. more landmarks give tighter bound but cost more memory and time per estimate.
+		*/
+		template<typename WeightFunctionT>
+		Landmarks(AML::Graph<VT, ET>* target_graph, WeightFunctionT GetEdgeWeight, int landmark_number,
+				  Selection selection = Selection::Farthest)
+		{
+			Build(target_graph, GetEdgeWeight, landmark_number, selection);
+		}
+
+	protected:
+		std::vector<AML::Vertex<VT, ET>*> vertex_list;
+
+		//vertex index of each landmark
+		std::vector<int> landmark_indices;
+
+		//distance from landmark i to vertex v is at [v * landmark_number + i]. max float if not reachable
+		std::vector<float> distances;
+
+		int landmark_number = 0;
+
+	public:
+		/**	select landmarks and run Dijkstra from each of them. calls ResetVertexIndex of target_graph.
+		*@note	O(k (V + E) log V) for k landmarks
+		*/
+		template<typename WeightFunctionT>
+		void Build(AML::Graph<VT, ET>* target_graph, WeightFunctionT GetEdgeWeight, int landmark_number,
+				   Selection selection = Selection::Farthest);
+
+		/**	lower bound of the shortest distance between two vertices.
+		*@return	0 if one of them is not in the graph preprocessed
+		*/
+		float Estimate(AML::Vertex<VT, ET>* vertex, AML::Vertex<VT, ET>* end_vertex) const
+		{
+			if(!Contains(vertex) || !Contains(end_vertex)) return 0.0f;
+			const float* vertex_distances = &distances[std::size_t(vertex->index) * landmark_number];
+			const float* end_distances = &distances[std::size_t(end_vertex->index) * landmark_number];
+			const float unreachable = std::numeric_limits<float>::max();
+			float result = 0.0f;
+			for(int i = 0; i < landmark_number; i++)
+			{
+				//a landmark in other component tells nothing
+				if(vertex_distances[i] == unreachable || end_distances[i] == unreachable) continue;
+				result = std::max(result, std::abs(end_distances[i] - vertex_distances[i]));
+			}
+			return result;
+		}
+
+		//same as Estimate. in the form of the heuristic of AStarAlgorithm
+		float operator()(AML::Vertex<VT, ET>* &vertex, AML::Vertex<VT, ET>* &end_vertex) const
+		{
+			return Estimate(vertex, end_vertex);
+		}
+
+		bool Contains(AML::Vertex<VT, ET>* vertex) const
+		{
+			if(vertex == nullptr) return false;
+			if(vertex->index < 0 || vertex->index >= int(vertex_list.size())) return false;
+			return vertex_list[vertex->index] == vertex;
+		}
+
+		int GetLandmarkNumber() const { return landmark_number; }
+
+		AML::Vertex<VT, ET>* GetLandmark(int i) const { return vertex_list[landmark_indices[i]]; }
+
+		//distance from i th landmark to the vertex of given index
+		float GetDistance(int i, int vertex_index) const { return distances[std::size_t(vertex_index) * landmark_number + i]; }
+
+		//bytes used by the distance tables
+		std::size_t GetMemoryUsage() const
+		{
+			return vertex_list.capacity() * sizeof(AML::Vertex<VT, ET>*)
+				+ landmark_indices.capacity() * sizeof(int)
+				+ distances.capacity() * sizeof(float);
+		}
+
+	protected:
+		/**	internal function of Build. Dijkstra from source over the whole snapshot
+		*/
+		static void _Search(const AML::CompressedGraph<VT, ET>& snapshot, SearchSpace<float>& search, int source);
+	};
+
+	template<typename VT, typename ET>
+	inline void Landmarks<VT, ET>::_Search(const AML::CompressedGraph<VT, ET>& snapshot, SearchSpace<float>& search, int source)
+	{
+		search.Reset();
+		search.Start(source, 0.0f);
+		while(!search.heap.Empty())
+		{
+			int current = search.Settle();
+			const float current_distance = search.distances[current];
+			for(int i = snapshot.offsets[current]; i < snapshot.offsets[current + 1]; i++)
+			{
+				search.Relax(snapshot.neighbors[i], current_distance + snapshot.weights[i], current);
+			}
+		}
+	}
+
+	template<typename VT, typename ET>
+	template<typename WeightFunctionT>
+	inline void Landmarks<VT, ET>::Build(AML::Graph<VT, ET>* target_graph, WeightFunctionT GetEdgeWeight, int landmark_number,
+										 Selection selection)
+	{
+		if(target_graph == nullptr) throw std::invalid_argument("target_graph == nullptr");
+		if(landmark_number < 0) throw std::invalid_argument("landmark_number < 0");
+
+		AML::CompressedGraph<VT, ET> snapshot(target_graph, GetEdgeWeight);
+		vertex_list = snapshot.vertex_list;
+		const int network_size = snapshot.GetVertexNumber();
+		this->landmark_number = std::min(landmark_number, network_size);
+
+		landmark_indices.clear();
+		distances.assign(std::size_t(network_size) * this->landmark_number, std::numeric_limits<float>::max());
+		if(this->landmark_number == 0) return;
+
+		SearchSpace<float> search(network_size);
+
+		if(selection == Selection::Degree)
+		{
+			std::vector<int> order(network_size);
+			for(int i = 0; i < network_size; i++) order[i] = i;
+			std::partial_sort(order.begin(), order.begin() + this->landmark_number, order.end(),
+							  [&snapshot](int left, int right)->bool
+							  {
+								  if(snapshot.GetDegree(left) != snapshot.GetDegree(right)) return snapshot.GetDegree(left) > snapshot.GetDegree(right);
+								  return left < right;
+							  });
+			landmark_indices.assign(order.begin(), order.begin() + this->landmark_number);
+		}
+		else
+		{
+			//first landmark is the farthest one from the vertex with biggest degree, which is likely in the largest component
+			int hub = 0;
+			for(int i = 1; i < network_size; i++)
+			{
+				if(snapshot.GetDegree(i) > snapshot.GetDegree(hub)) hub = i;
+			}
+			_Search(snapshot, search, hub);
+			int farthest = hub;
+			for(int i : search.settled)
+			{
+				if(search.distances[i] > search.distances[farthest]) farthest = i;
+			}
+			landmark_indices.push_back(farthest);
+		}
+
+		//distance to the nearest landmark, used by farthest selection
+		std::vector<float> nearest_distances(network_size, std::numeric_limits<float>::max());
+		std::vector<char> is_landmark(network_size, 0);
+		is_landmark[landmark_indices.front()] = 1;
+		for(int i = 0; i < this->landmark_number; i++)
+		{
+			_Search(snapshot, search, landmark_indices[i]);
+			for(int index : search.settled)
+			{
+				const float distance = search.distances[index];
+				distances[std::size_t(index) * this->landmark_number + i] = distance;
+				if(distance < nearest_distances[index]) nearest_distances[index] = distance;
+			}
+
+			if(selection == Selection::Farthest && i + 1 < this->landmark_number)
+			{
+				//landmarks are skipped, as zero weight edges can leave other vertices at distance 0 as well.
+				//vertices not reached by any landmark are taken only when every reached one is at distance 0
+				int farthest = -1;
+				int unreached = -1;
+				for(int index = 0; index < network_size; index++)
+				{
+					if(is_landmark[index]) continue;
+					if(nearest_distances[index] == std::numeric_limits<float>::max())
+					{
+						if(unreached == -1) unreached = index;
+					}
+					else if(farthest == -1 || nearest_distances[index] > nearest_distances[farthest])
+					{
+						farthest = index;
+					}
+				}
+				if(unreached != -1 && (farthest == -1 || nearest_distances[farthest] == 0.0f)) farthest = unreached;
+				is_landmark[farthest] = 1;
+				landmark_indices.push_back(farthest);
+			}
+		}
+	}
+}
@@ -1,169 +1,541 @@
 #pragma once
 
 #include "AdjacencyMultiList.h"
+#include "CompressedGraph.h"
 #include "UnionFind.h"
+#include "IndexedHeap.h"
+#include "ThreadPool.h"
 #include <random>
 #include <ctime>
-#include <queue>
+#include <algorithm>
+#include <limits>
+#include <functional>
+#include <array>
+#include <thread>
 
 namespace MinimunSpanningTree
 {
 	namespace AML = AdjacencyMultiList;
 
+	/**	where PrimAlgorithm and KruskalAlgorithm of Graph read the weights while they compare edges
+	*/
+	enum class WeightStorage
+	{
+		//Prim calls GetEdgeWeight whenever it scans an edge, and Kruskal calls it once per edge while packing them
+		Pointer,
+		//edges are numbered once and their weights are gathered into a dense array.
+		//heaps and sorts work on (weight, edge id) pairs without touching the edges. costs O(V + E) memory for the snapshot.
+		Dense
+	};
+
 	/** Find Minimum Spanning Tree of given graph by using Prim-Algorithm. ־ ׷  ˰ ̿ ּҽƮ մϴ.
-	* @param	*GetEdgeWeight	: The Fuction which get weight from the pointer of edge
+	* @param	GetEdgeWeight	: The Fuction which get weight from the pointer of edge. function pointer, lambda or object. AML::EdgeData() reads the data of edge directly.
 	* @param	target_graph	: pointer of graph
 	* @param	start_index		: index to start seaching. if out of range, the fuction will use random index.
 	* @return	the std::vector of selected edges which form the spanning tree
 	* @tparam	VT	: type of vertex's data
 	* @tparam	ET	: type of edge's data
-	* @note	time complexity : if used binary heap and adjacency list, O(E(log(V)))
+	* @tparam	WeightFunctionT	: type of GetEdgeWeight. weights are compared in the type it returns.
+	* @param	weight_storage	: WeightStorage::Dense runs on the Compressed Sparse Row snapshot of graph, built inside.
+	* @note	eager Prim. the heap keeps one entry per vertex, keyed by the lightest edge to the tree, and lowers it with decrease-key (IndexedHeap.h).
+	*		time complexity : O(E + V log(V)) heap operations at most, space : O(V)
 	*/
-	template<typename VT, typename ET>
-	std::vector<AML::Edge<VT, ET>*> PrimAlgorithm(float (*GetEdgeWeight)(AML::Edge<VT, ET>* &), AML::Graph<VT, ET> *target_graph, int start_index = -1);
+	template<typename VT, typename ET, typename WeightFunctionT>
+	std::vector<AML::Edge<VT, ET>*> PrimAlgorithm(WeightFunctionT GetEdgeWeight, AML::Graph<VT, ET> *target_graph, int start_index = -1,
+												  WeightStorage weight_storage = WeightStorage::Pointer);
 
 	/** Find Minimum Spanning Tree of given graph by using Kruskal-Algorithm. ־ ׷ ũ罺Į ˰ ̿ ּҽƮ մϴ.
-	* @param	*GetEdgeWeight	: The Fuction which get weight from the pointer of edge
+	* @param	GetEdgeWeight	: The Fuction which get weight from the pointer of edge. function pointer, lambda or object. AML::EdgeData() reads the data of edge directly.
 	* @param	target_graph	: pointer of graph
 	* @return	the std::vector of selected edges which form the spanning tree
 	* @tparam	VT	: type of vertex's data
 	* @tparam	ET	: type of edge's data
-	* @note	time complexity : O(E(log(E)))
+	* @tparam	WeightFunctionT	: type of GetEdgeWeight. weights are compared in the type it returns.
+	* @param	weight_storage	: WeightStorage::Dense runs on the Compressed Sparse Row snapshot of graph, built inside.
+	*							  WeightStorage::Pointer packs (weight, id, vertices) of each edge straight from the graph, calling GetEdgeWeight once per edge.
+	* @param	thread_number	: threads which partition and filter the edges. 0 uses std::thread::hardware_concurrency()
+	* @note	Filter-Kruskal. edges lighter than a pivot are solved first, then heavier edges whose ends are connected already are dropped before they are sorted.
+	*		expected time complexity : O(E + V log(V) log(E / V)). stops as soon as V - 1 edges are selected.
+	*		ties are broken by the order of edges in the graph, so the tree doesn't depend on thread_number.
+	*/
+	template<typename VT, typename ET, typename WeightFunctionT>
+	std::vector<AML::Edge<VT, ET>*> KruskalAlgorithm(WeightFunctionT GetEdgeWeight, AML::Graph<VT, ET> *target_graph,
+													 WeightStorage weight_storage = WeightStorage::Pointer, int thread_number = 0);
+
+	/** Prim-Algorithm on the Compressed Sparse Row snapshot of graph. weights are taken from the snapshot.
+	* @param	target_graph	: pointer of snapshot
+	* @param	start_index		: index to start seaching. if out of range, the fuction will use random index.
+	* @return	the std::vector of selected edges which form the spanning tree
+	*/
+	template<typename VT, typename ET, typename WeightT>
+	std::vector<AML::Edge<VT, ET>*> PrimAlgorithm(const AML::CompressedGraph<VT, ET, WeightT> *target_graph, int start_index = -1);
+
+	/** Kruskal-Algorithm on the Compressed Sparse Row snapshot of graph. weights are taken from the snapshot.
+	* @param	target_graph	: pointer of snapshot
+	* @return	the std::vector of selected edges which form the spanning tree
+	* @param	thread_number	: threads which partition and filter the edges. 0 uses std::thread::hardware_concurrency()
+	* @note	Filter-Kruskal on (weight, id, vertices) records, same as KruskalAlgorithm of Graph.
+	*/
+	template<typename VT, typename ET, typename WeightT>
+	std::vector<AML::Edge<VT, ET>*> KruskalAlgorithm(const AML::CompressedGraph<VT, ET, WeightT> *target_graph, int thread_number = 0);
+
+	/** Find Minimum Spanning Forest of given graph by using Boruvka-Algorithm.
+	*	every round, each component picks its lightest outgoing edge in parallel, and the components are merged by those edges with ConcurrentUnionFindTree.
+	*	edges inside one component are dropped after each round. the number of components is at least halved by every round.
+	* @param	GetEdgeWeight	: The Fuction which get weight from the pointer of edge. called once per edge.
+	* @param	target_graph	: pointer of graph
+	* @param	thread_number	: 0 uses std::thread::hardware_concurrency()
+	* @return	edges of minimum spanning tree of every connected component, (V - number of components) edges.
+	*			same edges in same order as KruskalAlgorithm, as ties are broken in the same way.
+	* @note	time complexity : O(E log(V)) work over O(log(V)) rounds
+	*/
+	template<typename VT, typename ET, typename WeightFunctionT>
+	std::vector<AML::Edge<VT, ET>*> BoruvkaAlgorithm(WeightFunctionT GetEdgeWeight, AML::Graph<VT, ET> *target_graph, int thread_number = 0);
+
+	/** Boruvka-Algorithm on the Compressed Sparse Row snapshot of graph. weights are taken from the snapshot.
+	* @return	same as BoruvkaAlgorithm of Graph
 	*/
-	template<typename VT, typename ET>
-	std::vector<AML::Edge<VT, ET>*> KruskalAlgorithm(float (*GetEdgeWeight)(AML::Edge<VT, ET>* &), AML::Graph<VT, ET> *target_graph);
+	template<typename VT, typename ET, typename WeightT>
+	std::vector<AML::Edge<VT, ET>*> BoruvkaAlgorithm(const AML::CompressedGraph<VT, ET, WeightT> *target_graph, int thread_number = 0);
 
-	template<typename VT, typename ET>
-	std::vector<AML::Edge<VT, ET>*> PrimAlgorithm(float (*GetEdgeWeight)(AML::Edge<VT, ET>* &), AML::Graph<VT, ET> *target_graph, int start_index)
+	/**	internal record of Kruskal. an edge packed with its weight, id and two vertex indices
+	*/
+	template<typename WeightT>
+	struct _KruskalEdge
 	{
-		std::vector<AML::Edge<VT, ET>*> result_edges;
-		const int network_size = target_graph->vertex_list.size();
-		if(network_size < 2) return result_edges;
-		result_edges.reserve(network_size - 1);
-		if(start_index < 0 || network_size <= start_index)
+		WeightT weight;
+		int id;
+		std::array<int, 2> vertex;
+
+		//order of Kruskal. ties are broken by smaller id
+		bool operator<(const _KruskalEdge& other) const
 		{
-			srand(time(NULL));
-			start_index = rand() % network_size;
+			if(weight != other.weight) return weight < other.weight;
+			return id < other.id;
 		}
+	};
 
+	/**	internal function of Kruskal and Boruvka. numbers every edge once, from the list of its vertex[0], and packs it with its weight.
+	*@note	calls ResetVertexIndex of target_graph
+	*/
+	template<typename VT, typename ET, typename WeightFunctionT, typename WeightT>
+	void _PackEdges(WeightFunctionT& GetEdgeWeight, AML::Graph<VT, ET> *target_graph,
+					std::vector<AML::Edge<VT, ET>*>& edge_list, std::vector<_KruskalEdge<WeightT>>& edges)
+	{
 		target_graph->ResetVertexIndex();
+		const int network_size = int(target_graph->vertex_list.size());
 
-		std::vector<bool> visited_mark(network_size, false);
+		edge_list.clear();
+		edges.clear();
+		edge_list.reserve(target_graph->GetEdgeNumber());
+		edges.reserve(target_graph->GetEdgeNumber());
+		for(int i = 0; i < network_size; i++)
+		{
+			AML::Vertex<VT, ET>* vertex = target_graph->vertex_list[i];
+			AML::Edge<VT, ET>* current_edge = vertex->GetFront();
+			while(current_edge != nullptr)
+			{
+				if(current_edge->GetVertex(0) == vertex)
+				{
+					const int id = int(edge_list.size());
+					edge_list.push_back(current_edge);
+					edges.push_back(_KruskalEdge<WeightT>{WeightT(GetEdgeWeight(current_edge)), id, {{i, current_edge->GetOpposite(vertex)->index}}});
+				}
+				current_edge = current_edge->GetNext(vertex);
+			}
+		}
+	}
 
-		auto comp = [&GetEdgeWeight](AML::Edge<VT, ET>* &back, AML::Edge<VT, ET>* &front)
-			-> bool { return GetEdgeWeight(back) > GetEdgeWeight(front); };
+	/**	internal function of Kruskal. selects edges of [begin, end) in Kruskal order until tree_size edges are selected.
+	*	ranges smaller than base_size are sorted. larger ones are partitioned by a pivot, and the heavy part is filtered after the light part is solved.
+	*	partition and filter of large ranges run on thread_number threads, using buffer of the same size as edges.
+	*/
+	template<typename WeightT>
+	void _FilterKruskal(std::vector<_KruskalEdge<WeightT>>& edges, std::vector<_KruskalEdge<WeightT>>& buffer, int begin, int end,
+						UnionFindTree& union_find_tree, std::vector<int>& selected_ids, int tree_size, int thread_number)
+	{
+		const int base_size = 1 << 12;
 
-		std::priority_queue<AML::Edge<VT, ET>*, std::vector<AML::Edge<VT, ET>*>, decltype(comp)> shortest_edge(comp);
+		if(begin >= end || int(selected_ids.size()) >= tree_size) return;
+		const int size = end - begin;
 
-		visited_mark[start_index] = true;
+		//pivot is the median of samples spread over the range
+		std::array<_KruskalEdge<WeightT>, 9> samples;
+		if(size > base_size)
 		{
-			std::vector<AML::Edge<VT, ET>*> edges = target_graph->vertex_list[start_index]->GetEdges();
-			while(!edges.empty())
+			for(int i = 0; i < int(samples.size()); i++)
 			{
-				shortest_edge.push(edges.back());
-				edges.pop_back();
+				samples[i] = edges[begin + int((long long)size * (2 * i + 1) / (2 * int(samples.size())))];
 			}
+			std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
 		}
+		const _KruskalEdge<WeightT>& pivot = samples[samples.size() / 2];
 
-		while(!shortest_edge.empty())
+		int light_number = size;
+		if(size > base_size)
 		{
-			AML::Edge<VT, ET>* current_edge = shortest_edge.top();
-			shortest_edge.pop();
-			AML::Vertex<VT, ET>* target_vertex = nullptr;
-			for(AML::Vertex<VT, ET>* vertex : current_edge->GetVertex())
+			const int chunk_number = (thread_number > 1 && size >= parallel_threshold) ? thread_number : 1;
+			if(chunk_number == 1)
 			{
-				if(!visited_mark[vertex->index])
+				light_number = int(std::partition(edges.begin() + begin, edges.begin() + end,
+												  [&pivot](const _KruskalEdge<WeightT>& edge)->bool{ return !(pivot < edge); }) - (edges.begin() + begin));
+			}
+			else
+			{
+				//count light edges of each chunk, then scatter both parts into buffer at their offsets
+				std::vector<int> light_counts(chunk_number, 0);
+				ForEachChunk(chunk_number, size, [&](int chunk, int chunk_begin, int chunk_end)
+				{
+					int count = 0;
+					for(int i = begin + chunk_begin; i < begin + chunk_end; i++)
+					{
+						if(!(pivot < edges[i])) ++count;
+					}
+					light_counts[chunk] = count;
+				});
+				std::vector<int> light_offsets(chunk_number, begin);
+				std::vector<int> heavy_offsets(chunk_number, begin);
+				light_number = 0;
+				for(int chunk = 0; chunk < chunk_number; chunk++) light_number += light_counts[chunk];
+				int heavy_offset = begin + light_number;
+				int light_offset = begin;
+				for(int chunk = 0; chunk < chunk_number; chunk++)
 				{
-					target_vertex = vertex;
-					break;
+					light_offsets[chunk] = light_offset;
+					heavy_offsets[chunk] = heavy_offset;
+					light_offset += light_counts[chunk];
+					heavy_offset += int((long long)size * (chunk + 1) / chunk_number - (long long)size * chunk / chunk_number) - light_counts[chunk];
 				}
+				ForEachChunk(chunk_number, size, [&](int chunk, int chunk_begin, int chunk_end)
+				{
+					int light_cursor = light_offsets[chunk];
+					int heavy_cursor = heavy_offsets[chunk];
+					for(int i = begin + chunk_begin; i < begin + chunk_end; i++)
+					{
+						if(!(pivot < edges[i])) buffer[light_cursor++] = edges[i];
+						else buffer[heavy_cursor++] = edges[i];
+					}
+				});
+				ForEachChunk(chunk_number, size, [&](int, int chunk_begin, int chunk_end)
+				{
+					std::copy(buffer.begin() + begin + chunk_begin, buffer.begin() + begin + chunk_end, edges.begin() + begin + chunk_begin);
+				});
 			}
-			if(target_vertex == nullptr) continue;
+		}
 
-			AML::Edge<VT, ET>* next_edge = target_vertex->GetFront();
-			while(next_edge != nullptr)
+		if(light_number == size)
+		{
+			//small range, or the pivot didn't split it
+			std::sort(edges.begin() + begin, edges.begin() + end);
+			for(int i = begin; i < end && int(selected_ids.size()) < tree_size; i++)
 			{
-				shortest_edge.push(next_edge);
-				next_edge = next_edge->GetNext(target_vertex);
+				if(union_find_tree.Union(edges[i].vertex[0], edges[i].vertex[1]))
+					selected_ids.push_back(edges[i].id);
 			}
-			visited_mark[target_vertex->index] = true;
-			result_edges.push_back(current_edge);
+			return;
 		}
 
-		return result_edges;
+		_FilterKruskal(edges, buffer, begin, begin + light_number, union_find_tree, selected_ids, tree_size, thread_number);
+		if(int(selected_ids.size()) >= tree_size) return;
+
+		//drop heavy edges which would make a cycle. each chunk is compacted in place, then chunks are moved together
+		const int heavy_begin = begin + light_number;
+		const int heavy_size = end - heavy_begin;
+		const int chunk_number = (thread_number > 1 && heavy_size >= parallel_threshold) ? thread_number : 1;
+		std::vector<int> kept_counts(chunk_number, 0);
+		ForEachChunk(chunk_number, heavy_size, [&](int chunk, int chunk_begin, int chunk_end)
+		{
+			int cursor = heavy_begin + chunk_begin;
+			for(int i = heavy_begin + chunk_begin; i < heavy_begin + chunk_end; i++)
+			{
+				//Find compresses paths, so chunks running together only read the tree
+				const bool is_cut = (chunk_number == 1)
+					? union_find_tree.Find(edges[i].vertex[0]) != union_find_tree.Find(edges[i].vertex[1])
+					: union_find_tree.FindRoot(edges[i].vertex[0]) != union_find_tree.FindRoot(edges[i].vertex[1]);
+				if(is_cut) edges[cursor++] = edges[i];
+			}
+			kept_counts[chunk] = cursor - (heavy_begin + chunk_begin);
+		});
+		int kept_end = heavy_begin + kept_counts[0];
+		for(int chunk = 1; chunk < chunk_number; chunk++)
+		{
+			const int chunk_begin = heavy_begin + int((long long)heavy_size * chunk / chunk_number);
+			kept_end = int(std::move(edges.begin() + chunk_begin, edges.begin() + chunk_begin + kept_counts[chunk], edges.begin() + kept_end) - edges.begin());
+		}
+
+		_FilterKruskal(edges, buffer, heavy_begin, kept_end, union_find_tree, selected_ids, tree_size, thread_number);
 	}
 
-	template<typename VT, typename ET>
-	std::vector<AML::Edge<VT, ET>*> KruskalAlgorithm(float (*GetEdgeWeight)(AML::Edge<VT, ET>* &), AML::Graph<VT, ET> *target_graph)
+	/**	internal function of Kruskal. selects the spanning tree among packed edges. edge_list gives the edge of each id.
+	*/
+	template<typename VT, typename ET, typename WeightT>
+	std::vector<AML::Edge<VT, ET>*> _KruskalEdges(std::vector<_KruskalEdge<WeightT>>& edges, const std::vector<AML::Edge<VT, ET>*>& edge_list,
+												  int network_size, int thread_number)
 	{
 		std::vector<AML::Edge<VT, ET>*> result_edges;
-		const int network_size = target_graph->vertex_list.size();
 		if(network_size < 2) return result_edges;
 		result_edges.reserve(network_size - 1);
 
-		const int edge_queue_max_size = 50000;
-		const int number_of_queue = (target_graph->GetEdgeNumber() / edge_queue_max_size) + 1;
-
-		target_graph->ResetVertexIndex();
+		if(thread_number <= 0) thread_number = int(std::thread::hardware_concurrency());
+		if(thread_number <= 0) thread_number = 1;
 
+		std::vector<_KruskalEdge<WeightT>> buffer(thread_number > 1 ? edges.size() : 0);
 		UnionFindTree union_find_tree(network_size);
+		std::vector<int> selected_ids;
+		selected_ids.reserve(network_size - 1);
+		_FilterKruskal(edges, buffer, 0, int(edges.size()), union_find_tree, selected_ids, network_size - 1, thread_number);
 
-		auto comp = [&GetEdgeWeight](AML::Edge<VT, ET>* &back, AML::Edge<VT, ET>* &front)
-			-> bool { return GetEdgeWeight(back) > GetEdgeWeight(front); };
-
-		std::vector<std::priority_queue<AML::Edge<VT, ET>*, std::vector<AML::Edge<VT, ET>*>, decltype(comp)>> edge_queues;
-
-		for(int i = 0; i < number_of_queue; i++)
+		for(int id : selected_ids)
 		{
-			edge_queues.emplace_back(comp);
+			result_edges.push_back(edge_list[id]);
 		}
+		return result_edges;
+	}
+
+	/**	internal function of Boruvka. selects the spanning forest among packed edges. edge_list gives the edge of each id.
+	*	edges is reordered and shrunk while the components are merged.
+	*/
+	template<typename VT, typename ET, typename WeightT>
+	std::vector<AML::Edge<VT, ET>*> _BoruvkaEdges(std::vector<_KruskalEdge<WeightT>>& edges, const std::vector<AML::Edge<VT, ET>*>& edge_list,
+												  int network_size, int thread_number)
+	{
+		std::vector<AML::Edge<VT, ET>*> result_edges;
+		if(network_size < 2) return result_edges;
+
+		if(thread_number <= 0) thread_number = int(std::thread::hardware_concurrency());
+		if(thread_number <= 0) thread_number = 1;
+		auto ChunkNumber = [thread_number](int size)->int{ return (size >= parallel_threshold) ? thread_number : 1; };
+
+		ConcurrentUnionFindTree union_find_tree(network_size);
+
+		//component of each vertex, which is the root of union_find_tree at the start of the round
+		std::vector<int> components(network_size);
+		for(int i = 0; i < network_size; i++) components[i] = i;
+
+		//position in edges of the lightest outgoing edge of each component, -1 if none
+		std::vector<std::atomic<int>> lightest(network_size);
 
-		target_graph->ResetAllEdgeMark();
-		int edge_counter = 0;
-		for(AML::Vertex<VT, ET>* vertex : target_graph->vertex_list)
+		//edges which merged two components
+		std::vector<_KruskalEdge<WeightT>> selected_edges;
+		selected_edges.reserve(network_size - 1);
+		std::vector<char> merged(network_size, 0);
+
+		int edge_number = int(edges.size());
+		while(edge_number > 0)
 		{
-			AML::Edge<VT, ET>* current_edge = vertex->GetFront();
-			while(current_edge != nullptr)
+			ForEachChunk(ChunkNumber(network_size), network_size, [&](int, int begin, int end)
 			{
-				if(!current_edge->mark)
+				for(int i = begin; i < end; i++)
 				{
-					current_edge->mark = true;
-					edge_queues[edge_counter / edge_queue_max_size].push(current_edge);
-					++edge_counter;
+					lightest[i].store(-1, std::memory_order_relaxed);
+					merged[i] = 0;
 				}
-				current_edge = current_edge->GetNext(vertex);
-			}
-		}
+			});
 
-		while(result_edges.size() < network_size - 1)
-		{
-			float min_weight = std::numeric_limits<float>::max();
-			int target_index = -1;
-			for(int i = 0; i < number_of_queue; i++)
+			ForEachChunk(ChunkNumber(edge_number), edge_number, [&](int, int begin, int end)
 			{
-				if(!edge_queues[i].empty())
+				for(int position = begin; position < end; position++)
 				{
-					AML::Edge<VT, ET>* temp = edge_queues[i].top();
-					float weight = GetEdgeWeight(temp);
-
-					if(weight < min_weight)
+					for(int component : {components[edges[position].vertex[0]], components[edges[position].vertex[1]]})
 					{
-						min_weight = weight;
-						target_index = i;
+						int current = lightest[component].load(std::memory_order_relaxed);
+						while((current == -1 || edges[position] < edges[current])
+							  && !lightest[component].compare_exchange_weak(current, position, std::memory_order_relaxed))
+						{
+						}
 					}
 				}
+			});
+
+			//each component merges along its lightest edge. an edge chosen by both of its components merges them once
+			ForEachChunk(ChunkNumber(network_size), network_size, [&](int, int begin, int end)
+			{
+				for(int component = begin; component < end; component++)
+				{
+					const int position = lightest[component].load(std::memory_order_relaxed);
+					if(position == -1) continue;
+					if(union_find_tree.Union(edges[position].vertex[0], edges[position].vertex[1])) merged[component] = 1;
+				}
+			});
+
+			const std::size_t selected_number = selected_edges.size();
+			for(int component = 0; component < network_size; component++)
+			{
+				if(merged[component]) selected_edges.push_back(edges[lightest[component].load(std::memory_order_relaxed)]);
+			}
+			if(selected_edges.size() == selected_number) break;
+
+			ForEachChunk(ChunkNumber(network_size), network_size, [&](int, int begin, int end)
+			{
+				for(int i = begin; i < end; i++)
+				{
+					components[i] = union_find_tree.Find(i);
+				}
+			});
+
+			//drop edges inside one component. each chunk is compacted in place, then chunks are moved together
+			const int chunk_number = ChunkNumber(edge_number);
+			std::vector<int> kept_counts(chunk_number, 0);
+			ForEachChunk(chunk_number, edge_number, [&](int chunk, int begin, int end)
+			{
+				int cursor = begin;
+				for(int i = begin; i < end; i++)
+				{
+					if(components[edges[i].vertex[0]] != components[edges[i].vertex[1]]) edges[cursor++] = edges[i];
+				}
+				kept_counts[chunk] = cursor - begin;
+			});
+			int kept_end = kept_counts[0];
+			for(int chunk = 1; chunk < chunk_number; chunk++)
+			{
+				const int chunk_begin = int((long long)edge_number * chunk / chunk_number);
+				kept_end = int(std::move(edges.begin() + chunk_begin, edges.begin() + chunk_begin + kept_counts[chunk], edges.begin() + kept_end) - edges.begin());
+			}
+			edge_number = kept_end;
+		}
+
+		//in Kruskal order
+		std::sort(selected_edges.begin(), selected_edges.end());
+		result_edges.reserve(selected_edges.size());
+		for(const _KruskalEdge<WeightT>& edge : selected_edges)
+		{
+			result_edges.push_back(edge_list[edge.id]);
+		}
+		return result_edges;
+	}
+
+	template<typename VT, typename ET, typename WeightFunctionT>
+	std::vector<AML::Edge<VT, ET>*> PrimAlgorithm(WeightFunctionT GetEdgeWeight, AML::Graph<VT, ET> *target_graph, int start_index,
+												  WeightStorage weight_storage)
+	{
+		if(weight_storage == WeightStorage::Dense)
+		{
+			AML::CompressedGraph<VT, ET, AML::EdgeWeightType<WeightFunctionT, VT, ET>> snapshot(target_graph, GetEdgeWeight);
+			return PrimAlgorithm(&snapshot, start_index);
+		}
+
+		std::vector<AML::Edge<VT, ET>*> result_edges;
+		const int network_size = target_graph->vertex_list.size();
+		if(network_size < 2) return result_edges;
+		result_edges.reserve(network_size - 1);
+		if(start_index < 0 || network_size <= start_index)
+		{
+			srand(time(NULL));
+			start_index = rand() % network_size;
+		}
+
+		target_graph->ResetVertexIndex();
+
+		//vertex keyed by the weight of the lightest edge connecting it to the tree
+		IndexedHeap<AML::EdgeWeightType<WeightFunctionT, VT, ET>> heap(network_size);
+		std::vector<AML::Edge<VT, ET>*> best_edges(network_size, nullptr);
+		std::vector<bool> tree_mark(network_size, false);
+
+		heap.Push(start_index, AML::EdgeWeightType<WeightFunctionT, VT, ET>());
+		while(!heap.Empty())
+		{
+			const int current_index = heap.Pop();
+			tree_mark[current_index] = true;
+			if(best_edges[current_index] != nullptr) result_edges.push_back(best_edges[current_index]);
+
+			AML::Vertex<VT, ET>* current_vertex = target_graph->vertex_list[current_index];
+			AML::Edge<VT, ET>* next_edge = current_vertex->GetFront();
+			while(next_edge != nullptr)
+			{
+				const int next_index = next_edge->GetOpposite(current_vertex)->index;
+				if(!tree_mark[next_index] && heap.PushOrDecrease(next_index, GetEdgeWeight(next_edge))) best_edges[next_index] = next_edge;
+				next_edge = next_edge->GetNext(current_vertex);
 			}
+		}
+
+		return result_edges;
+	}
+
+	template<typename VT, typename ET, typename WeightFunctionT>
+	std::vector<AML::Edge<VT, ET>*> KruskalAlgorithm(WeightFunctionT GetEdgeWeight, AML::Graph<VT, ET> *target_graph,
+													 WeightStorage weight_storage, int thread_number)
+	{
+		typedef AML::EdgeWeightType<WeightFunctionT, VT, ET> WeightT;
+
+		if(weight_storage == WeightStorage::Dense)
+		{
+			AML::CompressedGraph<VT, ET, WeightT> snapshot(target_graph, GetEdgeWeight);
+			return KruskalAlgorithm(&snapshot, thread_number);
+		}
+
+		std::vector<AML::Edge<VT, ET>*> edge_list;
+		std::vector<_KruskalEdge<WeightT>> edges;
+		_PackEdges(GetEdgeWeight, target_graph, edge_list, edges);
+
+		return _KruskalEdges(edges, edge_list, int(target_graph->vertex_list.size()), thread_number);
+	}
+
+	template<typename VT, typename ET, typename WeightT>
+	std::vector<AML::Edge<VT, ET>*> PrimAlgorithm(const AML::CompressedGraph<VT, ET, WeightT> *target_graph, int start_index)
+	{
+		std::vector<AML::Edge<VT, ET>*> result_edges;
+		const int network_size = target_graph->GetVertexNumber();
+		if(network_size < 2) return result_edges;
+		result_edges.reserve(network_size - 1);
+		if(start_index < 0 || network_size <= start_index)
+		{
+			srand(time(NULL));
+			start_index = rand() % network_size;
+		}
 
-			if(target_index == -1) break;
+		//vertex keyed by the weight of the lightest edge connecting it to the tree. the slot of that edge gives its id
+		IndexedHeap<WeightT> heap(network_size);
+		std::vector<int> best_slots(network_size, -1);
+		std::vector<bool> tree_mark(network_size, false);
 
-			AML::Edge<VT, ET>* target_edge = edge_queues[target_index].top();
-			edge_queues[target_index].pop();
+		heap.Push(start_index, WeightT());
+		while(!heap.Empty())
+		{
+			const int current_vertex = heap.Pop();
+			tree_mark[current_vertex] = true;
+			if(best_slots[current_vertex] != -1) result_edges.push_back(target_graph->edge_list[target_graph->edge_ids[best_slots[current_vertex]]]);
 
-			//union-find algorithm .
-						
-			if(union_find_tree.Union(target_edge->GetVertex(0)->index, target_edge->GetVertex(1)->index))
-				result_edges.push_back(target_edge);
+			for(int i = target_graph->offsets[current_vertex]; i < target_graph->offsets[current_vertex + 1]; i++)
+			{
+				const int next_vertex = target_graph->neighbors[i];
+				if(!tree_mark[next_vertex] && heap.PushOrDecrease(next_vertex, target_graph->weights[i])) best_slots[next_vertex] = i;
+			}
 		}
+
 		return result_edges;
 	}
+
+	template<typename VT, typename ET, typename WeightT>
+	std::vector<AML::Edge<VT, ET>*> KruskalAlgorithm(const AML::CompressedGraph<VT, ET, WeightT> *target_graph, int thread_number)
+	{
+		std::vector<_KruskalEdge<WeightT>> edges(target_graph->GetEdgeNumber());
+		for(int i = 0; i < int(edges.size()); i++)
+		{
+			edges[i] = _KruskalEdge<WeightT>{target_graph->edge_weights[i], i, target_graph->edge_vertices[i]};
+		}
+		return _KruskalEdges(edges, target_graph->edge_list, target_graph->GetVertexNumber(), thread_number);
+	}
+
+	template<typename VT, typename ET, typename WeightFunctionT>
+	std::vector<AML::Edge<VT, ET>*> BoruvkaAlgorithm(WeightFunctionT GetEdgeWeight, AML::Graph<VT, ET> *target_graph, int thread_number)
+	{
+		typedef AML::EdgeWeightType<WeightFunctionT, VT, ET> WeightT;
+
+		std::vector<AML::Edge<VT, ET>*> edge_list;
+		std::vector<_KruskalEdge<WeightT>> edges;
+		_PackEdges(GetEdgeWeight, target_graph, edge_list, edges);
+
+		return _BoruvkaEdges(edges, edge_list, int(target_graph->vertex_list.size()), thread_number);
+	}
+
+	template<typename VT, typename ET, typename WeightT>
+	std::vector<AML::Edge<VT, ET>*> BoruvkaAlgorithm(const AML::CompressedGraph<VT, ET, WeightT> *target_graph, int thread_number)
+	{
+		std::vector<_KruskalEdge<WeightT>> edges(target_graph->GetEdgeNumber());
+		for(int i = 0; i < int(edges.size()); i++)
+		{
+			edges[i] = _KruskalEdge<WeightT>{target_graph->edge_weights[i], i, target_graph->edge_vertices[i]};
+		}
+		return _BoruvkaEdges(edges, target_graph->edge_list, target_graph->GetVertexNumber(), thread_number);
+	}
 }
@@ -1,13 +1,20 @@
 #pragma once
 
 #include <random>
+#include <cmath>
+#include <thread>
+#include <algorithm>
+#include <unordered_set>
 #include "AdjacencyMultiList.h"
+#include "CompressedGraph.h"
+#include "ConnectedComponents.h"
 
 namespace Network
 {
 	namespace AML = AdjacencyMultiList;
 	
     /** Clear the Network and Connect Nodes to make ER Network
+    *@note same as ConnectGNPNetwork with probability mean_degree / (N - 1) and a random seed
     */
     template<typename VT, typename ET>
     void ConnectERNetwork(AML::Graph<VT, ET>* network, int mean_degree);
@@ -17,11 +24,38 @@ namespace Network
     template<typename VT, typename ET>
     void InitializeERNetwork(AML::Graph<VT, ET>* network, int mean_degree, int network_size = 0);
 
+    /** Clear the Network and connect each pair of vertices with given probability. G(n, p) model of ER Network
+    *@param probability    probability of each pair to be connected, in [0, 1]
+    *@param seed           same seed makes same network, whatever thread_number is
+    *@param thread_number  threads which draw the edges. 0 uses std::thread::hardware_concurrency()
+    *@note time complexity : O(N + E). the gap to the next connected pair is drawn from the geometric distribution (Batagelj-Brandes),
+    *      and the pairs are split into fixed chunks, each with its own random stream
+    */
+    template<typename VT, typename ET>
+    void ConnectGNPNetwork(AML::Graph<VT, ET>* network, double probability, unsigned int seed, int thread_number = 0);
+
+    /** Clear the Network and connect edge_number pairs of vertices chosen uniformly. G(n, m) model of ER Network
+    *@param seed   same seed makes same network
+    *@note time complexity : O(N + E) expected. when more than half of the pairs are asked, the pairs left out are chosen instead
+    */
+    template<typename VT, typename ET>
+    void ConnectGNMNetwork(AML::Graph<VT, ET>* network, long long edge_number, unsigned int seed);
+
+    /** internal function of ER Networks. vertex pair of index, counting (1, 0), (2, 0), (2, 1), (3, 0) ...
+    */
+    inline std::pair<int, int> _GetPair(unsigned long long pair_index);
+
     /** Clear the Network and Connect Nodes to make Barabasi-Albert Network
+    *@note time complexity : O(N m) for N vertices and m connection_per_step. targets are sampled from the array of edge endpoints
     */
     template<typename VT, typename ET>
     void ConnectBANetwork(AML::Graph<VT, ET>* network, int connection_per_step);
 
+    /** same as ConnectBANetwork, with the random seed given. same seed makes same network
+    */
+    template<typename VT, typename ET>
+    void ConnectBANetwork(AML::Graph<VT, ET>* network, int connection_per_step, unsigned int seed);
+
     /** Initialize Network with given size and Connect Nodes to make Barabasi-Albert Network
     */
     template<typename VT, typename ET>
@@ -32,10 +66,26 @@ namespace Network
     template<typename VT, typename ET>
     void InitializeLatticeNetwork(AML::Graph<VT, ET>* network, int x, int y);
 
-    /** sort by clusters
+    /** sort by clusters. vertices of each cluster are in the order of index
+    *@param thread_number  0 uses std::thread::hardware_concurrency()
+    *@note  ConnectedComponents gives the same result as flat arrays, without a vector for each cluster
     */
     template<typename VT, typename ET>
-    void FindClusters(AML::Graph<VT, ET>* network, std::vector<std::vector<AML::Vertex<VT, ET>*>> & return_reference);
+    void FindClusters(AML::Graph<VT, ET>* network, std::vector<std::vector<AML::Vertex<VT, ET>*>> & return_reference, int thread_number = 0);
+
+    /** sort by clusters, using the Compressed Sparse Row snapshot of network
+    */
+    template<typename VT, typename ET, typename WeightT>
+    void FindClusters(const AML::CompressedGraph<VT, ET, WeightT>* network, std::vector<std::vector<AML::Vertex<VT, ET>*>> & return_reference, int thread_number = 0);
+}
+
+inline std::pair<int, int> Network::_GetPair(unsigned long long pair_index)
+{
+    //row i holds pairs [i(i-1)/2, i(i+1)/2). the square root may be off by one on large indices
+    unsigned long long row = (unsigned long long)((1.0 + std::sqrt(1.0 + 8.0 * double(pair_index))) / 2.0);
+    while(row * (row - 1) / 2 > pair_index) --row;
+    while(row * (row + 1) / 2 <= pair_index) ++row;
+    return std::make_pair(int(row), int(pair_index - row * (row - 1) / 2));
 }
 
 template<typename VT, typename ET>
@@ -45,27 +95,163 @@ void Network::ConnectERNetwork(AML::Graph<VT, ET>* network, int mean_degree)
 
     if(network == nullptr) throw std::invalid_argument("network == nullptr");
 
-    network->ClearEdge();
+    if(network->vertex_list.size() < 2)
+    {
+        network->ClearEdge();
+        return;
+    }
 
     std::random_device rande;
 
-    std::minstd_rand generator_basic(rande());
+    double connect_ratio = std::min(1.0, double(mean_degree) / double(network->vertex_list.size() - 1));
+
+    Network::ConnectGNPNetwork(network, connect_ratio, rande());
+}
+
+template<typename VT, typename ET>
+void Network::ConnectGNPNetwork(AML::Graph<VT, ET>* network, double probability, unsigned int seed, int thread_number)
+{
+    if(network == nullptr) throw std::invalid_argument("network == nullptr");
+
+    if(!(probability >= 0.0 && probability <= 1.0)) throw std::invalid_argument("probability is not in [0, 1]");
+
+    network->ClearEdge();
+
+    const unsigned long long network_size = network->vertex_list.size();
+    const unsigned long long pair_number = network_size * (network_size - 1) / 2;
+    if(network_size < 2 || probability == 0.0) return;
 
-    std::uniform_real_distribution<float> uniform_dist(0.0f, 1.0f);
-    
-    float connect_ratio = float(mean_degree) / float(network->vertex_list.size() - 1);
+    //chunks depend only on the number of pairs, so threads change the speed but not the network
+    const unsigned long long chunk_size = 1ULL << 22;
+    const int chunk_number = int(std::min<unsigned long long>(256, (pair_number + chunk_size - 1) / chunk_size));
 
-    //Creating ER Network
-    for(int i = 1; i < network->vertex_list.size(); i++)
+    if(thread_number <= 0) thread_number = int(std::thread::hardware_concurrency());
+    if(thread_number <= 0) thread_number = 1;
+    thread_number = std::min(thread_number, chunk_number);
+
+    std::vector<std::vector<std::pair<int, int>>> chunk_pairs(chunk_number);
+    const double log_skip = std::log(1.0 - probability);
+
+    auto draw_chunk = [&](int chunk)
     {
-        for(int j = 0; j < i; j++)
+        const unsigned long long chunk_begin = pair_number * chunk / chunk_number;
+        const unsigned long long chunk_end = pair_number * (chunk + 1) / chunk_number;
+        std::vector<std::pair<int, int>>& edge_pairs = chunk_pairs[chunk];
+        edge_pairs.reserve(std::size_t(double(chunk_end - chunk_begin) * probability * 1.1) + 16);
+
+        std::seed_seq seed_sequence{seed, (unsigned int)chunk};
+        std::mt19937_64 generator(seed_sequence);
+        std::uniform_real_distribution<double> uniform_dist(0.0, 1.0);
+
+        std::pair<int, int> pair = Network::_GetPair(chunk_begin);
+        unsigned long long pair_index = chunk_begin;
+        while(true)
         {
-            if(uniform_dist(generator_basic) < connect_ratio)
+            //number of pairs skipped before the next connected one
+            unsigned long long skip = 0;
+            if(probability < 1.0)
             {
-                network->Connect(i, j);
+                const double gap = std::floor(std::log(1.0 - uniform_dist(generator)) / log_skip);
+                if(gap >= double(chunk_end - pair_index)) break;
+                skip = (unsigned long long)gap;
             }
+            pair_index += skip;
+            if(pair_index >= chunk_end) break;
+
+            //walk along rows. the skip is mostly shorter than a row, so this is O(1) on average
+            unsigned long long column = (unsigned long long)pair.second + skip;
+            while(column >= (unsigned long long)pair.first)
+            {
+                column -= pair.first;
+                ++pair.first;
+            }
+            pair.second = int(column);
+
+            edge_pairs.push_back(pair);
+
+            ++pair_index;
+            if(++pair.second == pair.first)
+            {
+                pair.second = 0;
+                ++pair.first;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for(int t = 0; t < thread_number; t++)
+    {
+        threads.emplace_back([&, t]()
+        {
+            for(int chunk = t; chunk < chunk_number; chunk += thread_number) draw_chunk(chunk);
+        });
+    }
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    std::vector<std::pair<int, int>> edge_pairs;
+    std::size_t total_size = 0;
+    for(const std::vector<std::pair<int, int>>& pairs : chunk_pairs) total_size += pairs.size();
+    edge_pairs.reserve(total_size);
+    for(std::vector<std::pair<int, int>>& pairs : chunk_pairs)
+    {
+        edge_pairs.insert(edge_pairs.end(), pairs.begin(), pairs.end());
+        std::vector<std::pair<int, int>>().swap(pairs);
+    }
+
+    network->ConnectBatch(edge_pairs);
+}
+
+template<typename VT, typename ET>
+void Network::ConnectGNMNetwork(AML::Graph<VT, ET>* network, long long edge_number, unsigned int seed)
+{
+    if(network == nullptr) throw std::invalid_argument("network == nullptr");
+
+    const unsigned long long network_size = network->vertex_list.size();
+    const unsigned long long pair_number = network_size < 2 ? 0 : network_size * (network_size - 1) / 2;
+    if(edge_number < 0 || (unsigned long long)edge_number > pair_number) throw std::invalid_argument("edge_number is not in [0, N(N-1)/2]");
+
+    network->ClearEdge();
+
+    //choose the smaller one of the pairs kept and the pairs left out
+    const bool choose_left_out = (unsigned long long)edge_number > pair_number / 2;
+    const unsigned long long choice_number = choose_left_out ? pair_number - edge_number : edge_number;
+
+    std::mt19937_64 generator(seed);
+    std::uniform_int_distribution<unsigned long long> pair_dist(0, pair_number == 0 ? 0 : pair_number - 1);
+
+    std::unordered_set<unsigned long long> chosen;
+    chosen.reserve(std::size_t(choice_number));
+    while(chosen.size() < choice_number)
+    {
+        chosen.insert(pair_dist(generator));
+    }
+
+    std::vector<unsigned long long> pair_indices;
+    pair_indices.reserve(std::size_t(edge_number));
+    if(choose_left_out)
+    {
+        for(unsigned long long i = 0; i < pair_number; i++)
+        {
+            if(chosen.find(i) == chosen.end()) pair_indices.push_back(i);
         }
     }
+    else
+    {
+        pair_indices.assign(chosen.begin(), chosen.end());
+        std::sort(pair_indices.begin(), pair_indices.end());
+    }
+
+    std::vector<std::pair<int, int>> edge_pairs;
+    edge_pairs.reserve(pair_indices.size());
+    for(unsigned long long pair_index : pair_indices)
+    {
+        edge_pairs.push_back(Network::_GetPair(pair_index));
+    }
+
+    network->ConnectBatch(edge_pairs);
 }
 
 template<typename VT, typename ET>
@@ -84,6 +270,14 @@ void Network::InitializeERNetwork(AML::Graph<VT, ET>* network, int mean_degree,
 
 template<typename VT, typename ET>
 void Network::ConnectBANetwork(AML::Graph<VT, ET>* network, int connection_per_step)
+{
+    std::random_device rande;
+
+    Network::ConnectBANetwork(network, connection_per_step, rande());
+}
+
+template<typename VT, typename ET>
+void Network::ConnectBANetwork(AML::Graph<VT, ET>* network, int connection_per_step, unsigned int seed)
 {
     if(network == nullptr) throw std::invalid_argument("network == nullptr");
     if(connection_per_step < 1) throw std::invalid_argument("connection_per_step < 1");
@@ -92,41 +286,53 @@ void Network::ConnectBANetwork(AML::Graph<VT, ET>* network, int connection_per_s
 
     network->ClearEdge();
 
-    std::random_device rande;
+    std::minstd_rand generator(seed);
 
-    std::minstd_rand generator(rande());
+    const int network_size = int(network->vertex_list.size());
 
-    std::uniform_real_distribution<float> uniform_dist(0.0f, 1.0f);
+    std::vector<std::pair<int, int>> edge_pairs;
+    edge_pairs.reserve(std::size_t(init_size) * (init_size - 1) / 2 + std::size_t(network_size - init_size) * connection_per_step);
+
+    //both ends of every edge. a vertex appears as many times as its degree,
+    //so a uniform pick from this array is a pick proportional to degree (Batagelj-Brandes)
+    std::vector<int> endpoints;
+    endpoints.reserve(edge_pairs.capacity() * 2);
+
+    //connected_step[v] == i if vertex i chose v already. checks duplicated edges in O(1)
+    std::vector<int> connected_step(network_size, -1);
 
     //make initail complete graph
     for(int i = 1; i < init_size; i++)
     {
         for(int j = 0; j < i; j++)
         {
-            network->Connect(i, j);
+            edge_pairs.emplace_back(i, j);
+            endpoints.push_back(i);
+            endpoints.push_back(j);
         }
     }
 
-    for(int i = init_size; i < network->vertex_list.size(); i++)
+    for(int i = init_size; i < network_size; i++)
     {
+        //targets are picked by the degrees before vertex i joined
+        std::uniform_int_distribution<std::size_t> endpoint_dist(0, endpoints.size() - 1);
         for(int j = 0; j < connection_per_step;)
         {
-            int target_degree_cumulative = int(uniform_dist(generator) * network->GetEdgeNumber() * 2);
-            int current_degree_cumulative = 0;
-            int target_index = 0;
-            while(target_index < i - 1)
-            {
-                current_degree_cumulative += network->vertex_list[target_index]->GetDegree();
-                if(current_degree_cumulative >= target_degree_cumulative) break;
-                target_index++;
-            }
-
-            if(network->IsConnected(i, target_index)) continue;
+            int target_index = endpoints[endpoint_dist(generator)];
+            if(connected_step[target_index] == i) continue;
+            connected_step[target_index] = i;
 
-            network->Connect(i, target_index);
+            edge_pairs.emplace_back(i, target_index);
             j++;
         }
+        for(std::size_t k = edge_pairs.size() - connection_per_step; k < edge_pairs.size(); k++)
+        {
+            endpoints.push_back(i);
+            endpoints.push_back(edge_pairs[k].second);
+        }
     }
+
+    network->ConnectBatch(edge_pairs);
 }
 
 template<typename VT, typename ET>
@@ -155,6 +361,9 @@ void Network::InitializeLatticeNetwork(AML::Graph<VT, ET>* network, int x_size,
     directions.emplace_back(1, 0);
     directions.emplace_back(-1, 0);
 
+    std::vector<std::pair<int, int>> edge_pairs;
+    edge_pairs.reserve(std::size_t(x_size) * y_size * directions.size());
+
     for(int x = 0; x < x_size; x++)
     {
         for(int y = 0; y < y_size; y++)
@@ -164,53 +373,25 @@ void Network::InitializeLatticeNetwork(AML::Graph<VT, ET>* network, int x_size,
                 int target_x = x + direction.first;
                 int target_y = y + direction.second;
                 if((target_x < 0) || (target_x >= x_size) || (target_y < 0) || (target_y >= y_size)) continue;
-                network->Connect((x * x_size) + y, (target_x * x_size) + target_y);
+                edge_pairs.emplace_back((x * x_size) + y, (target_x * x_size) + target_y);
             }
         }
     }
 
+    network->ConnectBatch(edge_pairs);
+
 }
 
 template<typename VT, typename ET>
-void Network::FindClusters(AML::Graph<VT, ET>* network, std::vector<std::vector<AML::Vertex<VT, ET>*>>& clusters_return)
+void Network::FindClusters(AML::Graph<VT, ET>* network, std::vector<std::vector<AML::Vertex<VT, ET>*>>& clusters_return, int thread_number)
 {
-    clusters_return.clear();
-    network->ResetVertexIndex();
-
-    std::vector<bool> vertex_marker(network->vertex_list.size(), false);
-    
-    std::deque<AML::Vertex<VT, ET>*> BFSQueue;
-    
-    for(int i = 0; i < network->vertex_list.size(); i++)
-    {
-        if(vertex_marker[i] == true) continue;
-
-        //initialize
-        vertex_marker[i] = true;
-        BFSQueue.clear();
-        clusters_return.push_back(std::vector<AML::Vertex<VT, ET>*>());
-        std::vector<AML::Vertex<VT, ET>*> &cluster = clusters_return.back();
-
-        //Broad First Search
-        BFSQueue.push_back(network->vertex_list[i]);
+    Network::ConnectedComponents<VT, ET> components(network, thread_number);
+    components.GetClusters(clusters_return);
+}
 
-        while(!BFSQueue.empty())
-        {
-            AML::Vertex<VT, ET>* current_vertex = BFSQueue.front();
-            AML::Edge<VT, ET>* current_edge = current_vertex->GetFront();
-            
-            while(current_edge != nullptr)
-            {
-                AML::Vertex<VT, ET>* opposite = current_edge->GetOpposite(current_vertex);
-                if((opposite != nullptr) && (vertex_marker[opposite->index] == false))
-                {
-                    BFSQueue.push_back(opposite);
-                    vertex_marker[opposite->index] = true;
-                }
-                current_edge = current_edge->GetNext(current_vertex);
-            }
-            cluster.push_back(current_vertex);
-            BFSQueue.pop_front();
-        }
-    }
-}
\ No newline at end of file
+template<typename VT, typename ET, typename WeightT>
+void Network::FindClusters(const AML::CompressedGraph<VT, ET, WeightT>* network, std::vector<std::vector<AML::Vertex<VT, ET>*>>& clusters_return, int thread_number)
+{
+    Network::ConnectedComponents<VT, ET> components(network, thread_number);
+    components.GetClusters(clusters_return);
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <utility>
+#include <type_traits>
+
+/**	Chunked object pool with freelist reuse.
+*	Objects are constructed inside fixed size chunks, so their addresses never change until the pool is reset.
+*	Destroyed slots are kept in a freelist and reused by the next Create.
+*@tparam	T	type of object stored in the pool
+*/
+template<typename T>
+class ObjectPool
+{
+protected:
+	union Slot
+	{
+		Slot* next;
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+	};
+
+	std::vector<std::unique_ptr<Slot[]>> chunks;
+
+	//number of slots per chunk
+	std::size_t chunk_size;
+
+	//chunk which is currently used for bump allocation, and offset inside of it
+	std::size_t current_chunk = 0;
+	std::size_t current_offset = 0;
+
+	Slot* free_list = nullptr;
+
+	std::size_t live_count = 0;
+
+public:
+	ObjectPool(std::size_t chunk_size = 4096) : chunk_size(chunk_size > 0 ? chunk_size : 1){}
+
+	ObjectPool(const ObjectPool&) = delete;
+	ObjectPool& operator=(const ObjectPool&) = delete;
+
+	/**	construct new object inside the pool
+	*@param	args	arguments forwarded to the constructor of T
+	*@return	pointer of constructed object. it is valid until Destroy or Reset.
+	*/
+	template<typename... Args>
+	T* Create(Args&&... args)
+	{
+		Slot* slot;
+		if(free_list != nullptr)
+		{
+			slot = free_list;
+			free_list = free_list->next;
+		}
+		else
+		{
+			if(current_chunk < chunks.size() && current_offset == chunk_size)
+			{
+				++current_chunk;
+				current_offset = 0;
+			}
+			if(current_chunk == chunks.size())
+			{
+				chunks.emplace_back(new Slot[chunk_size]);
+			}
+			slot = &chunks[current_chunk][current_offset++];
+		}
+		T* object = new(&slot->storage) T(std::forward<Args>(args)...);
+		++live_count;
+		return object;
+	}
+
+	/**	call destructor of the object and return its slot to the freelist
+	*@note	object must be created by this pool
+	*/
+	void Destroy(T* object)
+	{
+		if(object == nullptr) return;
+		object->~T();
+		Slot* slot = reinterpret_cast<Slot*>(object);
+		slot->next = free_list;
+		free_list = slot;
+		--live_count;
+	}
+
+	/**	rewind the pool without calling destructors. chunks are kept for reuse.
+	*@note	O(1). every object must be trivially destructible or already destroyed by the owner.
+	*/
+	void Reset()
+	{
+		current_chunk = 0;
+		current_offset = 0;
+		free_list = nullptr;
+		live_count = 0;
+	}
+
+	/**	allocate chunks in advance so that next (count) Create calls don't allocate memory
+	*/
+	void Reserve(std::size_t count)
+	{
+		std::size_t used = (current_chunk < chunks.size()) ? current_chunk * chunk_size + current_offset : chunks.size() * chunk_size;
+		std::size_t required = used + count;
+		while(chunks.size() * chunk_size < required)
+		{
+			chunks.emplace_back(new Slot[chunk_size]);
+		}
+	}
+
+	/**	free every chunk. same as Reset, destructors are not called.
+	*/
+	void Release()
+	{
+		Reset();
+		chunks.clear();
+	}
+
+	std::size_t GetLiveCount() const { return live_count; }
+
+	std::size_t GetCapacity() const { return chunks.size() * chunk_size; }
+};
@@ -0,0 +1,306 @@
+#pragma once
+
+#include "AdjacencyMultiList.h"
+#include "CompressedGraph.h"
+#include "ShortestPath.h"
+#include "ThreadPool.h"
+#include <thread>
+#include <atomic>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+
+namespace ShortestPath
+{
+	namespace AML = AdjacencyMultiList;
+
+	/**	Reusable barrier for a fixed team of threads, spinning with yield. std::barrier is not in C++14.
+	*/
+	class ThreadBarrier
+	{
+	public:
+		ThreadBarrier(int thread_number) : thread_number(thread_number){}
+
+		ThreadBarrier(const ThreadBarrier&) = delete;
+		ThreadBarrier& operator=(const ThreadBarrier&) = delete;
+
+		/**	block until every thread of the team calls Wait.
+		*	writes before Wait are visible to every thread after Wait.
+		*/
+		void Wait()
+		{
+			const unsigned int current_generation = generation.load(std::memory_order_acquire);
+			if(arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == thread_number)
+			{
+				arrived.store(0, std::memory_order_relaxed);
+				generation.fetch_add(1, std::memory_order_release);
+				return;
+			}
+			while(generation.load(std::memory_order_acquire) == current_generation)
+			{
+				std::this_thread::yield();
+			}
+		}
+
+	protected:
+		const int thread_number;
+		std::atomic<int> arrived{0};
+		std::atomic<unsigned int> generation{0};
+	};
+
+	/**	Delta-stepping single source shortest path tree, run by several threads.
+	*	tentative distances are kept in buckets of width delta. edges not heavier than delta are relaxed repeatedly
+	*	inside the current bucket, and heavier edges once after the bucket is emptied.
+	*	every vertex is owned by one thread (index % thread_number), and only the owner changes its distance.
+	*	other threads send relaxation requests, which are applied after a barrier. so no lock or atomic is used on vertices.
+	*@param	delta			width of buckets. 0 selects (max weight / mean degree).
+	*						small delta does less redundant work but needs more phases, large delta is closer to Bellman-Ford.
+	*@param	thread_number	0 uses std::thread::hardware_concurrency()
+	*@return	same as DijkstraAlgorithmTree. edge to previous vertex of each vertex index, nullptr for start_vertex and unreachable vertices
+	*@note	weights must not be negative. the result doesn't depend on timing of threads,
+	*		but when there are several shortest paths, the chosen one may differ from DijkstraAlgorithmTree.
+	*/
+	template<typename VT, typename ET>
+	std::vector<AML::Edge<VT, ET>*> DeltaSteppingTree(const AML::CompressedGraph<VT, ET> *target_graph,
+													  AML::Vertex<VT, ET>* start_vertex,
+													  float delta = 0.0f,
+													  int thread_number = 0)
+	{
+		std::vector<AML::Edge<VT, ET>*> result;
+		if(target_graph == nullptr) throw std::invalid_argument("target_graph == nullptr");
+		if(!target_graph->Contains(start_vertex))
+			return result;//if given vertex isn't in graph
+
+		const int network_size = target_graph->GetVertexNumber();
+		const std::vector<int>& offsets = target_graph->offsets;
+		const std::vector<int>& neighbors = target_graph->neighbors;
+		const std::vector<int>& edge_ids = target_graph->edge_ids;
+		const std::vector<float>& weights = target_graph->weights;
+
+		float max_weight = 0.0f;
+		for(float weight : target_graph->edge_weights)
+		{
+			if(weight < 0.0f) throw std::invalid_argument("negative weight");
+			max_weight = std::max(max_weight, weight);
+		}
+		if(!(delta > 0.0f))
+		{
+			double mean_degree = double(neighbors.size()) / network_size;
+			delta = float(max_weight / std::max(1.0, mean_degree));
+			if(!(delta > 0.0f)) delta = 1.0f;
+		}
+
+		if(thread_number <= 0) thread_number = int(std::thread::hardware_concurrency());
+		thread_number = std::max(1, std::min(thread_number, network_size));
+
+		//every tentative distance is inside [current bucket, current bucket + bucket_number), so buckets are reused cyclically
+		const long long bucket_number = (long long)(std::floor(max_weight / delta)) + 3;
+
+		struct Request
+		{
+			int target;
+			int edge_id;
+			float distance;
+		};
+
+		//per vertex data, touched only by the owner thread
+		std::vector<float> distances(network_size, std::numeric_limits<float>::max());
+		std::vector<int> prev_edge_ids(network_size, -1);
+		std::vector<long long> bucket_of(network_size, -1);
+		std::vector<char> queued(network_size, 0);
+		std::vector<long long> removed_bucket(network_size, -1);
+
+		//per thread data. outboxes[from][to] are written by thread from, and read by thread to after a barrier
+		std::vector<std::vector<std::vector<int>>> buckets(thread_number, std::vector<std::vector<int>>(std::size_t(bucket_number)));
+		std::vector<std::vector<std::vector<Request>>> outboxes(thread_number, std::vector<std::vector<Request>>(thread_number));
+		std::vector<long long> next_buckets(thread_number);
+		std::vector<char> pending(thread_number);
+
+		ThreadBarrier barrier(thread_number);
+		const long long no_bucket = std::numeric_limits<long long>::max();
+
+		auto Work = [&](int thread_id)
+		{
+			std::vector<std::vector<int>>& local_buckets = buckets[thread_id];
+			std::vector<int> frontier;
+			std::vector<int> removed;
+
+			auto Insert = [&](int vertex, long long bucket)
+			{
+				if(queued[vertex] && bucket_of[vertex] == bucket) return;
+				local_buckets[std::size_t(bucket % bucket_number)].push_back(vertex);
+				bucket_of[vertex] = bucket;
+				queued[vertex] = 1;
+			};
+
+			auto SendRequests = [&](int vertex, bool light)
+			{
+				const float vertex_distance = distances[vertex];
+				for(int i = offsets[vertex]; i < offsets[vertex + 1]; i++)
+				{
+					if((weights[i] <= delta) != light) continue;
+					const int target = neighbors[i];
+					outboxes[thread_id][target % thread_number].push_back(Request{target, edge_ids[i], vertex_distance + weights[i]});
+				}
+			};
+
+			auto ApplyRequests = [&](long long current_bucket)
+			{
+				for(int from = 0; from < thread_number; from++)
+				{
+					std::vector<Request>& inbox = outboxes[from][thread_id];
+					for(const Request& request : inbox)
+					{
+						if(!(request.distance < distances[request.target])) continue;
+						distances[request.target] = request.distance;
+						prev_edge_ids[request.target] = request.edge_id;
+						Insert(request.target, std::max(current_bucket, (long long)(request.distance / delta)));
+					}
+					inbox.clear();
+				}
+			};
+
+			if(start_vertex->index % thread_number == thread_id)
+			{
+				distances[start_vertex->index] = 0.0f;
+				Insert(start_vertex->index, 0);
+			}
+
+			long long current_bucket = 0;
+			while(true)
+			{
+				//find smallest non empty bucket of every thread
+				next_buckets[thread_id] = no_bucket;
+				for(long long i = 0; i < bucket_number; i++)
+				{
+					if(!local_buckets[std::size_t((current_bucket + i) % bucket_number)].empty())
+					{
+						next_buckets[thread_id] = current_bucket + i;
+						break;
+					}
+				}
+				barrier.Wait();
+				current_bucket = *std::min_element(next_buckets.begin(), next_buckets.end());
+				if(current_bucket == no_bucket) break;
+
+				//light edges, until no vertex is left in current bucket
+				removed.clear();
+				std::vector<int>& bucket = local_buckets[std::size_t(current_bucket % bucket_number)];
+				while(true)
+				{
+					frontier.clear();
+					frontier.swap(bucket);
+					for(int vertex : frontier)
+					{
+						if(!queued[vertex] || bucket_of[vertex] != current_bucket) continue;
+						queued[vertex] = 0;
+						if(removed_bucket[vertex] != current_bucket)
+						{
+							removed_bucket[vertex] = current_bucket;
+							removed.push_back(vertex);
+						}
+						SendRequests(vertex, true);
+					}
+					barrier.Wait();
+
+					ApplyRequests(current_bucket);
+					pending[thread_id] = !bucket.empty();
+					barrier.Wait();
+
+					if(std::find(pending.begin(), pending.end(), 1) == pending.end()) break;
+				}
+
+				//heavy edges of the vertices removed from current bucket, once
+				for(int vertex : removed)
+				{
+					SendRequests(vertex, false);
+				}
+				barrier.Wait();
+				ApplyRequests(current_bucket);
+			}
+		};
+
+		std::vector<std::thread> threads;
+		for(int i = 1; i < thread_number; i++)
+		{
+			threads.emplace_back(Work, i);
+		}
+		Work(0);
+		for(std::thread& thread : threads)
+		{
+			thread.join();
+		}
+
+		result.assign(network_size, nullptr);
+		for(int i = 0; i < network_size; i++)
+		{
+			if(prev_edge_ids[i] != -1) result[i] = target_graph->edge_list[prev_edge_ids[i]];
+		}
+		return result;
+	}
+
+	/**	Delta-stepping on the Compressed Sparse Row snapshot of given graph. the snapshot is built inside with float weights, O(V + E).
+	*@return	same as DijkstraAlgorithmTree
+	*/
+	template<typename VT, typename ET, typename WeightFunctionT>
+	std::vector<AML::Edge<VT, ET>*> DeltaSteppingTree(AML::Graph<VT, ET> *target_graph,
+													  WeightFunctionT GetEdgeWeight,
+													  AML::Vertex<VT, ET>* start_vertex,
+													  float delta = 0.0f,
+													  int thread_number = 0)
+	{
+		AML::CompressedGraph<VT, ET> snapshot(target_graph, GetEdgeWeight);
+		return DeltaSteppingTree(&snapshot, start_vertex, delta, thread_number);
+	}
+
+	/**	internal function of the batched queries. RunWithWorkspaces with the search buffers of Dijkstra.
+	*	Query is called as Query(request_index, workspace) on a worker, with the workspace of that worker.
+	*/
+	template<typename DistanceT, typename QueryT>
+	void _RunBatch(ThreadPool& pool, int request_number, QueryT Query)
+	{
+		RunWithWorkspaces<SearchSpace<DistanceT>>(pool, request_number, Query);
+	}
+
+	/**	shortest path trees from many sources, run on the workers of pool. each worker reuses its own search buffers.
+	*	the snapshot is only read during the run, so vertex->index of the original graph is never changed.
+	*@param	callback	called as callback(request_index, tree) on a worker thread as soon as each tree is finished.
+	*					tree is same as the result of DijkstraAlgorithmTree, and can be moved out.
+	*					callbacks run at the same time on several threads, so shared data must be guarded by the callback.
+	*@note	blocks until every tree is finished. must not be called by a task of the same pool.
+	*/
+	template<typename VT, typename ET, typename WeightT, typename CallbackT>
+	void MultiSourceDijkstraTree(const AML::CompressedGraph<VT, ET, WeightT> *target_graph,
+								 const std::vector<AML::Vertex<VT, ET>*>& sources,
+								 ThreadPool& pool,
+								 CallbackT callback)
+	{
+		if(target_graph == nullptr) throw std::invalid_argument("target_graph == nullptr");
+		_RunBatch<WeightT>(pool, int(sources.size()), [&](int request_index, SearchSpace<WeightT>& workspace)
+		{
+			std::vector<AML::Edge<VT, ET>*> tree = DijkstraAlgorithmTree(target_graph, sources[request_index], &workspace);
+			callback(request_index, tree);
+		});
+	}
+
+	/**	shortest paths of many (start, end) pairs, run on the workers of pool. each worker reuses its own search buffers.
+	*@param	callback	called as callback(request_index, path) on a worker thread as soon as each path is found.
+	*					path is same as the result of DijkstraAlgorithmPath, and can be moved out.
+	*					callbacks run at the same time on several threads, so shared data must be guarded by the callback.
+	*@note	blocks until every path is found. must not be called by a task of the same pool.
+	*/
+	template<typename VT, typename ET, typename WeightT, typename CallbackT>
+	void MultiPairDijkstraPath(const AML::CompressedGraph<VT, ET, WeightT> *target_graph,
+							   const std::vector<std::pair<AML::Vertex<VT, ET>*, AML::Vertex<VT, ET>*>>& vertex_pairs,
+							   ThreadPool& pool,
+							   CallbackT callback)
+	{
+		if(target_graph == nullptr) throw std::invalid_argument("target_graph == nullptr");
+		_RunBatch<WeightT>(pool, int(vertex_pairs.size()), [&](int request_index, SearchSpace<WeightT>& workspace)
+		{
+			std::vector<AML::Vertex<VT, ET>*> path
+				= DijkstraAlgorithmPath(target_graph, vertex_pairs[request_index].first, vertex_pairs[request_index].second, &workspace);
+			callback(request_index, path);
+		});
+	}
+}
@@ -0,0 +1,268 @@
+#pragma once
+
+#include "AdjacencyMultiList.h"
+#include "CompressedGraph.h"
+#include "UnionFind.h"
+#include "Ensemble.h"
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+
+namespace Network
+{
+	namespace AML = AdjacencyMultiList;
+
+	enum class PercolationMode
+	{
+		//vertices are occupied one by one. an edge is open when both of its ends are occupied
+		Site,
+		//every vertex is there, and edges are occupied one by one
+		Bond
+	};
+
+	/**	observables of a percolation sweep, for every number of occupied sites or bonds.
+	*	index n of each curve is the state after n sites (or bonds) are occupied, from 0 to N (or E).
+	*/
+	struct PercolationCurve
+	{
+		//size of the largest cluster
+		std::vector<int> largest_sizes;
+
+		//number of clusters. only occupied vertices make clusters in site mode
+		std::vector<int> cluster_numbers;
+
+		//sum of squared sizes of every cluster but the largest one, divided by the number of vertices
+		std::vector<double> susceptibilities;
+
+		//occupation steps where size_distributions were taken
+		std::vector<int> snapshot_steps;
+
+		//size_distributions[k][s] is the number of clusters of size s at snapshot_steps[k]. sized up to the largest cluster
+		std::vector<std::vector<int>> size_distributions;
+	};
+
+	/**	Newman-Ziff percolation. sites or bonds are occupied in a random order, and the clusters are merged on a union-find tree,
+	*	so the whole curve is measured in one sweep of O(E α(V)).
+	*@param	mode				PercolationMode::Site or PercolationMode::Bond
+	*@param	seed				seed of the order. same seed gives same curve on every platform
+	*@param	snapshot_fractions	occupation fractions in [0, 1] where the cluster size distribution is copied
+	*@note	the curves are for fixed numbers of occupied sites or bonds. BinomialAverage turns them into curves of occupation probability.
+	*		calls ResetVertexIndex of target_graph.
+	*/
+	template<typename VT, typename ET>
+	PercolationCurve NewmanZiff(AML::Graph<VT, ET>* target_graph, PercolationMode mode, std::uint64_t seed,
+								const std::vector<double>& snapshot_fractions = std::vector<double>());
+
+	/**	Newman-Ziff percolation on the Compressed Sparse Row snapshot of graph
+	*/
+	template<typename VT, typename ET, typename WeightT>
+	PercolationCurve NewmanZiff(const AML::CompressedGraph<VT, ET, WeightT>* target_graph, PercolationMode mode, std::uint64_t seed,
+								const std::vector<double>& snapshot_fractions = std::vector<double>());
+
+	/**	value at occupation probability of a curve measured for fixed numbers of occupied sites or bonds.
+	*	sum of values[n] weighted by the binomial distribution B(N, probability), where N = values.size() - 1
+	*/
+	template<typename T>
+	double BinomialAverage(const std::vector<T>& values, double probability);
+
+	/**	internal function of NewmanZiff. random permutation of [0, size) drawn from CounterRandom, same on every platform
+	*/
+	inline std::vector<int> _RandomOrder(int size, std::uint64_t seed)
+	{
+		std::vector<int> order(size);
+		for(int i = 0; i < size; i++) order[i] = i;
+		CounterRandom random(seed);
+		for(int i = size - 1; i > 0; i--)
+		{
+			std::swap(order[i], order[int(random() % std::uint64_t(i + 1))]);
+		}
+		return order;
+	}
+
+	/**	internal function of NewmanZiff. occupies the vertices (site mode) or the edges (bond mode) in given order.
+	*	Neighbors(vertex, Function) calls Function(neighbor) for each edge of vertex, and edges holds both ends of each edge.
+	*/
+	template<typename NeighborsT>
+	PercolationCurve _NewmanZiff(int network_size, const std::vector<std::pair<int, int>>& edges, NeighborsT Neighbors,
+								 PercolationMode mode, const std::vector<int>& order, const std::vector<double>& snapshot_fractions)
+	{
+		const int step_number = int(order.size());
+
+		PercolationCurve curve;
+		curve.largest_sizes.resize(step_number + 1);
+		curve.cluster_numbers.resize(step_number + 1);
+		curve.susceptibilities.resize(step_number + 1);
+
+		for(double fraction : snapshot_fractions)
+		{
+			if(!(fraction >= 0.0 && fraction <= 1.0)) throw std::invalid_argument("snapshot fraction is not in [0, 1]");
+			curve.snapshot_steps.push_back(int(std::lround(fraction * step_number)));
+		}
+		std::sort(curve.snapshot_steps.begin(), curve.snapshot_steps.end());
+		curve.size_distributions.resize(curve.snapshot_steps.size());
+		std::size_t next_snapshot = 0;
+
+		UnionFindTree union_find_tree(network_size);
+		//number of clusters of each size
+		std::vector<int> size_counts(network_size + 1, 0);
+		int largest_size = 0;
+		int cluster_number = 0;
+		//sum of squared cluster sizes
+		double squared_sum = 0.0;
+
+		auto Merge = [&](int x, int y)
+		{
+			const int x_root = union_find_tree.Find(x);
+			const int y_root = union_find_tree.Find(y);
+			if(x_root == y_root) return;
+			const int x_size = union_find_tree.sizes[x_root];
+			const int y_size = union_find_tree.sizes[y_root];
+			--size_counts[x_size];
+			--size_counts[y_size];
+			++size_counts[x_size + y_size];
+			squared_sum += 2.0 * double(x_size) * double(y_size);
+			--cluster_number;
+			largest_size = std::max(largest_size, x_size + y_size);
+			union_find_tree.Union(x_root, y_root);
+		};
+
+		auto Record = [&](int step)
+		{
+			curve.largest_sizes[step] = largest_size;
+			curve.cluster_numbers[step] = cluster_number;
+			curve.susceptibilities[step] = network_size == 0 ? 0.0
+				: (squared_sum - double(largest_size) * double(largest_size)) / network_size;
+			while(next_snapshot < curve.snapshot_steps.size() && curve.snapshot_steps[next_snapshot] == step)
+			{
+				curve.size_distributions[next_snapshot].assign(size_counts.begin(), size_counts.begin() + largest_size + 1);
+				++next_snapshot;
+			}
+		};
+
+		if(mode == PercolationMode::Site)
+		{
+			std::vector<char> occupied(network_size, 0);
+			Record(0);
+			for(int step = 1; step <= step_number; step++)
+			{
+				const int vertex = order[step - 1];
+				occupied[vertex] = 1;
+				++size_counts[1];
+				++cluster_number;
+				squared_sum += 1.0;
+				largest_size = std::max(largest_size, 1);
+				Neighbors(vertex, [&](int neighbor){ if(occupied[neighbor]) Merge(vertex, neighbor); });
+				Record(step);
+			}
+		}
+		else
+		{
+			//every vertex is a cluster of its own at the start
+			size_counts[1] = network_size;
+			cluster_number = network_size;
+			squared_sum = double(network_size);
+			largest_size = network_size > 0 ? 1 : 0;
+			Record(0);
+			for(int step = 1; step <= step_number; step++)
+			{
+				const std::pair<int, int>& edge = edges[order[step - 1]];
+				Merge(edge.first, edge.second);
+				Record(step);
+			}
+		}
+
+		return curve;
+	}
+
+	template<typename VT, typename ET>
+	PercolationCurve NewmanZiff(AML::Graph<VT, ET>* target_graph, PercolationMode mode, std::uint64_t seed,
+								const std::vector<double>& snapshot_fractions)
+	{
+		if(target_graph == nullptr) throw std::invalid_argument("target_graph == nullptr");
+
+		target_graph->ResetVertexIndex();
+		const std::vector<AML::Vertex<VT, ET>*>& vertex_list = target_graph->vertex_list;
+
+		std::vector<std::pair<int, int>> edges;
+		if(mode == PercolationMode::Bond)
+		{
+			edges.reserve(target_graph->GetEdgeNumber());
+			for(AML::Vertex<VT, ET>* vertex : vertex_list)
+			{
+				for(AML::Edge<VT, ET>* edge = vertex->GetFront(); edge != nullptr; edge = edge->GetNext(vertex))
+				{
+					//each edge once, from its first vertex
+					if(edge->GetVertex(0) == vertex) edges.emplace_back(vertex->index, edge->GetOpposite(vertex)->index);
+				}
+			}
+		}
+
+		const int network_size = int(vertex_list.size());
+		return _NewmanZiff(network_size, edges, [&vertex_list](int index, auto Function)
+		{
+			AML::Vertex<VT, ET>* vertex = vertex_list[index];
+			for(AML::Edge<VT, ET>* edge = vertex->GetFront(); edge != nullptr; edge = edge->GetNext(vertex))
+			{
+				Function(edge->GetOpposite(vertex)->index);
+			}
+		}, mode, _RandomOrder(mode == PercolationMode::Site ? network_size : int(edges.size()), seed), snapshot_fractions);
+	}
+
+	template<typename VT, typename ET, typename WeightT>
+	PercolationCurve NewmanZiff(const AML::CompressedGraph<VT, ET, WeightT>* target_graph, PercolationMode mode, std::uint64_t seed,
+								const std::vector<double>& snapshot_fractions)
+	{
+		if(target_graph == nullptr) throw std::invalid_argument("target_graph == nullptr");
+
+		const int network_size = target_graph->GetVertexNumber();
+
+		std::vector<std::pair<int, int>> edges;
+		if(mode == PercolationMode::Bond)
+		{
+			//each edge is in the rows of both ends. taken from the first slot of its id
+			edges.resize(target_graph->GetEdgeNumber(), std::make_pair(-1, -1));
+			for(int vertex = 0; vertex < network_size; vertex++)
+			{
+				for(int i = target_graph->offsets[vertex]; i < target_graph->offsets[vertex + 1]; i++)
+				{
+					std::pair<int, int>& edge = edges[target_graph->edge_ids[i]];
+					if(edge.first == -1) edge = std::make_pair(vertex, target_graph->neighbors[i]);
+				}
+			}
+		}
+
+		return _NewmanZiff(network_size, edges, [target_graph](int vertex, auto Function)
+		{
+			for(int i = target_graph->offsets[vertex]; i < target_graph->offsets[vertex + 1]; i++)
+			{
+				Function(target_graph->neighbors[i]);
+			}
+		}, mode, _RandomOrder(mode == PercolationMode::Site ? network_size : int(edges.size()), seed), snapshot_fractions);
+	}
+
+	template<typename T>
+	double BinomialAverage(const std::vector<T>& values, double probability)
+	{
+		if(values.empty()) return 0.0;
+		if(!(probability >= 0.0 && probability <= 1.0)) throw std::invalid_argument("probability is not in [0, 1]");
+
+		const int total = int(values.size()) - 1;
+		if(probability == 0.0) return double(values.front());
+		if(probability == 1.0) return double(values.back());
+
+		//weights are computed in log space, and terms far from the mode are too small to matter
+		const double log_p = std::log(probability);
+		const double log_q = std::log(1.0 - probability);
+		const double log_total = std::lgamma(total + 1.0);
+		double result = 0.0;
+		for(int n = 0; n <= total; n++)
+		{
+			const double log_weight = log_total - std::lgamma(n + 1.0) - std::lgamma(total - n + 1.0) + n * log_p + (total - n) * log_q;
+			if(log_weight < -745.0) continue;
+			result += std::exp(log_weight) * double(values[n]);
+		}
+		return result;
+	}
+}
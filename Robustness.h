@@ -0,0 +1,235 @@
+#pragma once
+
+#include "AdjacencyMultiList.h"
+#include "CompressedGraph.h"
+#include "Percolation.h"
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+
+namespace Network
+{
+	namespace AML = AdjacencyMultiList;
+
+	enum class AttackStrategy
+	{
+		//vertices in a random order. failure of random vertices
+		Random,
+		//vertices with bigger degree first, by the degrees of the intact graph
+		Degree,
+		//vertex with the biggest degree among the vertices left, recomputed after every removal.
+		//among same degree, the vertex whose degree dropped last comes first, and smaller index before any drop
+		AdaptiveDegree
+	};
+
+	/**	order in which an attack removes the vertices of graph. calls ResetVertexIndex of target_graph.
+	*@param	seed	used by AttackStrategy::Random only
+	*@note	ties of Degree are broken by smaller index, and ties of AdaptiveDegree as written on it.
+	*		AdaptiveDegree keeps vertices in buckets by degree, so every strategy is O(V + E)
+	*/
+	template<typename VT, typename ET>
+	std::vector<AML::Vertex<VT, ET>*> AttackOrder(AML::Graph<VT, ET>* target_graph, AttackStrategy strategy, std::uint64_t seed = 0);
+
+	/**	order of vertex indices in which an attack removes the vertices of the Compressed Sparse Row snapshot of graph
+	*/
+	template<typename VT, typename ET, typename WeightT>
+	std::vector<int> AttackOrder(const AML::CompressedGraph<VT, ET, WeightT>* target_graph, AttackStrategy strategy, std::uint64_t seed = 0);
+
+	/**	clusters of graph while its vertices are removed in given order. the removals are replayed backward as insertions on a union-find tree,
+	*	so the whole curve takes O(E α(V)) instead of finding the clusters after every removal.
+	*@param	removal_order	vertices to remove, first one first. any order works, like the one of AttackOrder or one sorted by betweenness.
+	*						vertices not in it are removed after it, in the order of index.
+	*@return	index k of each curve is the state after k vertices are removed, from 0 to N. largest_sizes is the giant component curve.
+	*		snapshot_steps and size_distributions are empty.
+	*@note	calls ResetVertexIndex of target_graph.
+	*/
+	template<typename VT, typename ET>
+	PercolationCurve AttackCurve(AML::Graph<VT, ET>* target_graph, const std::vector<AML::Vertex<VT, ET>*>& removal_order);
+
+	/**	AttackCurve on the Compressed Sparse Row snapshot of graph, with vertex indices
+	*/
+	template<typename VT, typename ET, typename WeightT>
+	PercolationCurve AttackCurve(const AML::CompressedGraph<VT, ET, WeightT>* target_graph, const std::vector<int>& removal_order);
+
+	/**	internal function of AttackOrder. degrees are the degrees of intact graph.
+	*	Neighbors(vertex, Function) calls Function(neighbor) for each edge of vertex.
+	*/
+	template<typename NeighborsT>
+	std::vector<int> _AttackOrder(const std::vector<int>& degrees, NeighborsT Neighbors, AttackStrategy strategy, std::uint64_t seed)
+	{
+		const int network_size = int(degrees.size());
+		if(strategy == AttackStrategy::Random) return _RandomOrder(network_size, seed);
+
+		const int max_degree = network_size == 0 ? 0 : *std::max_element(degrees.begin(), degrees.end());
+		std::vector<int> order;
+		order.reserve(network_size);
+
+		if(strategy == AttackStrategy::Degree)
+		{
+			//counting sort by degree, bigger first
+			std::vector<int> offsets(max_degree + 2, 0);
+			for(int degree : degrees) ++offsets[max_degree - degree + 1];
+			for(int i = 0; i <= max_degree; i++) offsets[i + 1] += offsets[i];
+			order.resize(network_size);
+			for(int i = 0; i < network_size; i++) order[offsets[max_degree - degrees[i]]++] = i;
+			return order;
+		}
+
+		//doubly linked list of vertices for each degree. degrees only go down, so the biggest bucket is found by moving down.
+		//a vertex whose degree dropped is put in front of its new bucket, so ties aren't broken by index after the first removal
+		std::vector<int> current_degrees(degrees);
+		std::vector<int> heads(max_degree + 1, -1);
+		std::vector<int> nexts(network_size, -1);
+		std::vector<int> befores(network_size, -1);
+		std::vector<char> removed(network_size, 0);
+
+		auto Insert = [&](int vertex)
+		{
+			int& head = heads[current_degrees[vertex]];
+			befores[vertex] = -1;
+			nexts[vertex] = head;
+			if(head != -1) befores[head] = vertex;
+			head = vertex;
+		};
+		auto Erase = [&](int vertex)
+		{
+			if(befores[vertex] != -1) nexts[befores[vertex]] = nexts[vertex];
+			else heads[current_degrees[vertex]] = nexts[vertex];
+			if(nexts[vertex] != -1) befores[nexts[vertex]] = befores[vertex];
+		};
+
+		//inserted backward, so smaller index is in front among same degrees
+		for(int i = network_size - 1; i >= 0; i--) Insert(i);
+
+		int top_degree = max_degree;
+		for(int step = 0; step < network_size; step++)
+		{
+			while(heads[top_degree] == -1) --top_degree;
+			const int vertex = heads[top_degree];
+			Erase(vertex);
+			removed[vertex] = 1;
+			order.push_back(vertex);
+			Neighbors(vertex, [&](int neighbor)
+			{
+				if(removed[neighbor]) return;
+				Erase(neighbor);
+				--current_degrees[neighbor];
+				Insert(neighbor);
+			});
+		}
+		return order;
+	}
+
+	/**	internal function of AttackCurve. removal_order is completed and checked here
+	*/
+	template<typename NeighborsT>
+	PercolationCurve _AttackCurve(int network_size, NeighborsT Neighbors, const std::vector<int>& removal_order)
+	{
+		std::vector<char> listed(network_size, 0);
+		std::vector<int> insertion_order;
+		insertion_order.reserve(network_size);
+		for(int vertex : removal_order)
+		{
+			if(vertex < 0 || vertex >= network_size) throw std::invalid_argument("vertex of removal_order is not in graph");
+			if(listed[vertex]) throw std::invalid_argument("vertex is in removal_order twice");
+			listed[vertex] = 1;
+		}
+		for(int i = network_size - 1; i >= 0; i--)
+		{
+			if(!listed[i]) insertion_order.push_back(i);
+		}
+		insertion_order.insert(insertion_order.end(), removal_order.rbegin(), removal_order.rend());
+
+		//state after k insertions is the state after N - k removals
+		PercolationCurve curve = _NewmanZiff(network_size, std::vector<std::pair<int, int>>(), Neighbors, PercolationMode::Site,
+											 insertion_order, std::vector<double>());
+		std::reverse(curve.largest_sizes.begin(), curve.largest_sizes.end());
+		std::reverse(curve.cluster_numbers.begin(), curve.cluster_numbers.end());
+		std::reverse(curve.susceptibilities.begin(), curve.susceptibilities.end());
+		return curve;
+	}
+
+	template<typename VT, typename ET>
+	std::vector<AML::Vertex<VT, ET>*> AttackOrder(AML::Graph<VT, ET>* target_graph, AttackStrategy strategy, std::uint64_t seed)
+	{
+		if(target_graph == nullptr) throw std::invalid_argument("target_graph == nullptr");
+
+		target_graph->ResetVertexIndex();
+		const std::vector<AML::Vertex<VT, ET>*>& vertex_list = target_graph->vertex_list;
+		std::vector<int> degrees(vertex_list.size());
+		for(std::size_t i = 0; i < vertex_list.size(); i++) degrees[i] = vertex_list[i]->GetDegree();
+
+		std::vector<int> order = _AttackOrder(degrees, [&vertex_list](int index, auto Function)
+		{
+			AML::Vertex<VT, ET>* vertex = vertex_list[index];
+			for(AML::Edge<VT, ET>* edge = vertex->GetFront(); edge != nullptr; edge = edge->GetNext(vertex))
+			{
+				Function(edge->GetOpposite(vertex)->index);
+			}
+		}, strategy, seed);
+
+		std::vector<AML::Vertex<VT, ET>*> result;
+		result.reserve(order.size());
+		for(int index : order) result.push_back(vertex_list[index]);
+		return result;
+	}
+
+	template<typename VT, typename ET, typename WeightT>
+	std::vector<int> AttackOrder(const AML::CompressedGraph<VT, ET, WeightT>* target_graph, AttackStrategy strategy, std::uint64_t seed)
+	{
+		if(target_graph == nullptr) throw std::invalid_argument("target_graph == nullptr");
+
+		std::vector<int> degrees(target_graph->GetVertexNumber());
+		for(int i = 0; i < int(degrees.size()); i++) degrees[i] = target_graph->GetDegree(i);
+
+		return _AttackOrder(degrees, [target_graph](int vertex, auto Function)
+		{
+			for(int i = target_graph->offsets[vertex]; i < target_graph->offsets[vertex + 1]; i++)
+			{
+				Function(target_graph->neighbors[i]);
+			}
+		}, strategy, seed);
+	}
+
+	template<typename VT, typename ET>
+	PercolationCurve AttackCurve(AML::Graph<VT, ET>* target_graph, const std::vector<AML::Vertex<VT, ET>*>& removal_order)
+	{
+		if(target_graph == nullptr) throw std::invalid_argument("target_graph == nullptr");
+
+		target_graph->ResetVertexIndex();
+		const std::vector<AML::Vertex<VT, ET>*>& vertex_list = target_graph->vertex_list;
+
+		std::vector<int> indices;
+		indices.reserve(removal_order.size());
+		for(AML::Vertex<VT, ET>* vertex : removal_order)
+		{
+			if(vertex == nullptr || vertex->index < 0 || vertex->index >= int(vertex_list.size()) || vertex_list[vertex->index] != vertex)
+				throw std::invalid_argument("vertex of removal_order is not in graph");
+			indices.push_back(vertex->index);
+		}
+
+		return _AttackCurve(int(vertex_list.size()), [&vertex_list](int index, auto Function)
+		{
+			AML::Vertex<VT, ET>* vertex = vertex_list[index];
+			for(AML::Edge<VT, ET>* edge = vertex->GetFront(); edge != nullptr; edge = edge->GetNext(vertex))
+			{
+				Function(edge->GetOpposite(vertex)->index);
+			}
+		}, indices);
+	}
+
+	template<typename VT, typename ET, typename WeightT>
+	PercolationCurve AttackCurve(const AML::CompressedGraph<VT, ET, WeightT>* target_graph, const std::vector<int>& removal_order)
+	{
+		if(target_graph == nullptr) throw std::invalid_argument("target_graph == nullptr");
+
+		return _AttackCurve(target_graph->GetVertexNumber(), [target_graph](int vertex, auto Function)
+		{
+			for(int i = target_graph->offsets[vertex]; i < target_graph->offsets[vertex + 1]; i++)
+			{
+				Function(target_graph->neighbors[i]);
+			}
+		}, removal_order);
+	}
+}
@@ -1,241 +1,892 @@
 #pragma once
 
 #include "AdjacencyMultiList.h"
+#include "CompressedGraph.h"
+#include "IndexedHeap.h"
 #include <queue>
-#include <set>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+#include <functional>
 
 namespace ShortestPath
 {
 	namespace AML = AdjacencyMultiList;
-	
-	template<typename VT, typename ET>
-	std::vector<AML::Vertex<VT,ET>*> DijkstraAlgorithmPath(AML::Graph<VT, ET> *target_graph,
-														 float (*GetEdgeWeight)(AML::Edge<VT, ET>* &),
-														 AML::Vertex<VT,ET>* start_vertex,
-														 AML::Vertex<VT,ET>* end_vertex)
+
+	/**	Reusable buffers of one search.
+	*	every vertex has a stamp, and the data of a vertex is valid only when its stamp is same as current epoch.
+	*	so Reset is O(1) and a search touches only the vertices it reaches.
+	*@tparam	DistanceT	type of distance
+	*/
+	template<typename DistanceT = float>
+	class SearchSpace
 	{
-		std::vector<AML::Vertex<VT, ET>*> result;
-		target_graph->ResetVertexIndex();
-		if((target_graph->vertex_list[start_vertex->index] != start_vertex) || (target_graph->vertex_list[end_vertex->index] != end_vertex))
-			return result;//if given vertex isn't in graph
+	public:
+		SearchSpace(){}
+
+		SearchSpace(int size)
+		{
+			Initialize(size);
+		}
 
-		const int network_size = target_graph->vertex_list.size();
+	public:
+		std::vector<DistanceT> distances;
 
-		//vector to save distance from start_node if distance is 0.0f, it means that the vertex is already visited or start node.
-		std::vector<float> distances(network_size, std::numeric_limits<float>::max());
-		distances[start_vertex->index] = 0.0f;
-		
-		//vector to save index of previous node in shortest path
-		std::vector<int> prev_index(network_size, -1);
-		prev_index[start_vertex->index] = start_vertex->index;
+		//index of previous vertex in shortest path. same as own index for the start vertex.
+		std::vector<int> prev_index;
 
-		//distance compare function
-		auto comp = [&distances](AML::Vertex<VT, ET>* front, AML::Vertex<VT, ET>* back)
-			-> bool
+		std::vector<unsigned int> stamps;
+
+		//reached vertices which are not settled yet
+		IndexedHeap<DistanceT> heap;
+
+		//settled vertices in settled order
+		std::vector<int> settled;
+
+		//exact distance of each reached vertex in the searches of WeightType::Integer, which distances may round when DistanceT is float.
+		//sized by the first of those searches
+		std::vector<long long> integer_distances;
+
+	protected:
+		unsigned int epoch = 1;
+
+	public:
+		/**	resize buffers for (size) vertices. O(size)
+		*/
+		void Initialize(int size)
 		{
-			float bd = distances[back->index];
-			float fd = distances[front->index];
-			if(bd != fd) return bd > fd;
-			return front->index < back->index;
-		};
+			distances.assign(size, std::numeric_limits<DistanceT>::max());
+			prev_index.assign(size, -1);
+			stamps.assign(size, 0);
+			heap.Initialize(size);
+			settled.clear();
+			epoch = 1;
+		}
 
-		std::set<AML::Vertex<VT, ET>*, decltype(comp)> min_tree(comp);
+		/**	forget previous search. O(1) except the items left in heap.
+		*/
+		void Reset()
+		{
+			heap.Clear();
+			settled.clear();
+			++epoch;
+			if(epoch == 0)
+			{
+				//stamps overflowed. happens once in 2^32 searches
+				std::fill(stamps.begin(), stamps.end(), 0);
+				epoch = 1;
+			}
+		}
+
+		int GetSize() const { return int(stamps.size()); }
+
+		bool IsReached(int index) const { return stamps[index] == epoch; }
+
+		bool IsSettled(int index) const { return IsReached(index) && !heap.Contains(index); }
 
-		for(AML::Vertex<VT, ET>* vertex : target_graph->vertex_list)
+		DistanceT GetDistance(int index) const { return IsReached(index) ? distances[index] : std::numeric_limits<DistanceT>::max(); }
+
+		int GetPrevIndex(int index) const { return IsReached(index) ? prev_index[index] : -1; }
+
+		/**	set the start vertex of search
+		*/
+		void Start(int index, DistanceT distance)
 		{
-			min_tree.insert(vertex);
+			stamps[index] = epoch;
+			distances[index] = distance;
+			prev_index[index] = index;
+			heap.Push(index, distance);
 		}
 
-		while(!min_tree.empty())
+		/**	lower the distance of vertex if given distance is shorter. settled vertices are never changed.
+		*@return	true if distance is changed
+		*/
+		bool Relax(int index, DistanceT distance, int previous)
 		{
-			typename std::set<AML::Vertex<VT, ET>*, decltype(comp)>::iterator iter = min_tree.begin();
-			AML::Vertex<VT, ET>* current_vertex = *iter;
-			min_tree.erase(iter);
-			if(current_vertex == end_vertex) break;
-			AML::Edge<VT, ET>* current_edge = current_vertex->GetFront();
-			while(current_edge != nullptr)
+			if(!IsReached(index))
 			{
-				AML::Vertex<VT, ET>* opposite = current_edge->GetOpposite(current_vertex);
-				if(distances[opposite->index] > 0.0f)
+				stamps[index] = epoch;
+				distances[index] = distance;
+				prev_index[index] = previous;
+				heap.Push(index, distance);
+				return true;
+			}
+			if(!heap.Contains(index) || !(distance < distances[index])) return false;
+			distances[index] = distance;
+			prev_index[index] = previous;
+			heap.DecreaseKey(index, distance);
+			return true;
+		}
+
+		/**	lower the distance of vertex if given distance is shorter, without the heap.
+		*	used by the searches which keep their own queue, instead of Relax.
+		*@return	true if distance is changed
+		*/
+		bool Update(int index, DistanceT distance, int previous)
+		{
+			if(IsReached(index) && !(distance < distances[index])) return false;
+			Set(index, distance, previous);
+			return true;
+		}
+
+		/**	set the distance of vertex without comparing. used by the searches which compare distances by themselves
+		*/
+		void Set(int index, DistanceT distance, int previous)
+		{
+			stamps[index] = epoch;
+			distances[index] = distance;
+			prev_index[index] = previous;
+		}
+
+		/**	pop the closest vertex of heap and mark it settled
+		*/
+		int Settle()
+		{
+			int index = heap.Pop();
+			settled.push_back(index);
+			return index;
+		}
+
+		/**	vertices between start and given vertex, by following prev_index
+		*@return	empty if given vertex is not reached
+		*/
+		std::vector<int> GetPath(int end_index) const
+		{
+			std::vector<int> path;
+			if(!IsReached(end_index)) return path;
+			int current_index = prev_index[end_index];
+			while(current_index != prev_index[current_index])
+			{
+				path.push_back(current_index);
+				current_index = prev_index[current_index];
+			}
+			std::reverse(path.begin(), path.end());
+			return path;
+		}
+	};
+
+	/**	Workspace for repeated shortest path queries on same graph.
+	*	buffers are allocated once, and invalidated by epoch instead of being filled again.
+	*	so a query costs time proportional to the area it explores, not O(V).
+	*@tparam	DistanceT	type of distance, same as the type of weight returned by GetEdgeWeight
+	*@note	Bind is called again automatically when the vertex_list of graph is changed.
+	*		changing only the edges doesn't need it.
+	*/
+	template<typename VT, typename ET, typename DistanceT = float>
+	class PathQueryContext
+	{
+	public:
+		PathQueryContext(AML::Graph<VT, ET>* target_graph)
+		{
+			Bind(target_graph);
+		}
+
+	public:
+		SearchSpace<DistanceT> forward;
+
+		//search from the end vertex, used by bidirectional algorithms
+		SearchSpace<DistanceT> backward;
+
+		//edge to previous vertex. valid only for reached vertices of forward
+		std::vector<AML::Edge<VT, ET>*> prev_edges;
+
+	protected:
+		AML::Graph<VT, ET>* target_graph = nullptr;
+
+	public:
+		/**	set the graph to search, and number its vertices. O(V)
+		*/
+		void Bind(AML::Graph<VT, ET>* graph)
+		{
+			if(graph == nullptr) throw std::invalid_argument("graph == nullptr");
+			target_graph = graph;
+			target_graph->ResetVertexIndex();
+			const int network_size = int(target_graph->vertex_list.size());
+			forward.Initialize(network_size);
+			backward.Initialize(network_size);
+			prev_edges.assign(network_size, nullptr);
+		}
+
+		/**	forget the previous query. O(1)
+		*/
+		void Reset()
+		{
+			forward.Reset();
+			backward.Reset();
+		}
+
+		AML::Graph<VT, ET>* GetGraph() const { return target_graph; }
+
+		/**	check given vertex is in the graph, rebinding once if the vertex_list was changed
+		*/
+		bool Prepare(AML::Vertex<VT, ET>* vertex)
+		{
+			if(IsBound(vertex)) return true;
+			Bind(target_graph);
+			return IsBound(vertex);
+		}
+
+		/**	number of vertices settled by the last query, sum of both directions
+		*/
+		int GetSettledCount() const { return int(forward.settled.size() + backward.settled.size()); }
+
+	protected:
+		bool IsBound(AML::Vertex<VT, ET>* vertex) const
+		{
+			if(vertex == nullptr) return false;
+			if(int(target_graph->vertex_list.size()) != forward.GetSize()) return false;
+			if(vertex->index < 0 || vertex->index >= forward.GetSize()) return false;
+			return target_graph->vertex_list[vertex->index] == vertex;
+		}
+	};
+
+	/**	declared kind of edge weights, which selects the queue of DijkstraAlgorithmPath and DijkstraAlgorithmTree.
+	*	every kind gives the same result as Real.
+	*/
+	enum class WeightType
+	{
+		//any non-negative weight. indexed heap
+		Real,
+		//non-negative integers. Dial's bucket queue, O(V + E + max distance)
+		Integer,
+		//every edge has same positive weight. breadth first search, O(V + E)
+		Uniform
+	};
+
+	/**	internal function of Dijkstra with WeightType::Integer. Dial's bucket queue, one bucket for each distance.
+	*	buckets are reused cyclically, and grow when a weight is not smaller than the number of buckets.
+	*	vertices of a bucket are settled in order of index, so the result is same as the heap which breaks ties by smaller index.
+	*	distances are compared as exact integers in search.integer_distances, so float distances past 2^24 don't lose vertices.
+	*@param	end_vertex	search stops when it is settled. nullptr to search every reachable vertex.
+	*/
+	template<typename VT, typename ET, typename DistanceT, typename WeightFunctionT>
+	void _DialSearch(PathQueryContext<VT, ET, DistanceT>* context,
+					 WeightFunctionT GetEdgeWeight,
+					 AML::Vertex<VT, ET>* start_vertex,
+					 AML::Vertex<VT, ET>* end_vertex)
+	{
+		AML::Graph<VT, ET>* target_graph = context->GetGraph();
+		context->Reset();
+		SearchSpace<DistanceT>& search = context->forward;
+		std::vector<long long>& integer_distances = search.integer_distances;
+		if(integer_distances.size() != search.distances.size()) integer_distances.assign(search.distances.size(), 0);
+		search.Set(start_vertex->index, DistanceT(0), start_vertex->index);
+		integer_distances[start_vertex->index] = 0;
+		context->prev_edges[start_vertex->index] = nullptr;
+
+		//buckets[d % buckets.size()] keeps vertices reached with distance d. outdated entries are skipped when popped
+		std::vector<std::vector<int>> buckets(2);
+		buckets[0].push_back(start_vertex->index);
+		long long queued_number = 1;
+
+		std::vector<int> current_bucket;
+		//vertices reached by zero weight edges while current bucket is settled
+		std::priority_queue<int, std::vector<int>, std::greater<int>> zero_queue;
+
+		for(long long distance = 0; queued_number > 0; distance++)
+		{
+			std::vector<int>& bucket = buckets[std::size_t(distance % (long long)buckets.size())];
+			if(bucket.empty()) continue;
+			queued_number -= (long long)bucket.size();
+			current_bucket.clear();
+			current_bucket.swap(bucket);
+			std::sort(current_bucket.begin(), current_bucket.end());
+
+			std::size_t cursor = 0;
+			while(cursor < current_bucket.size() || !zero_queue.empty())
+			{
+				int current_index;
+				if(zero_queue.empty() || (cursor < current_bucket.size() && current_bucket[cursor] < zero_queue.top()))
 				{
-					float alternative = distances[current_vertex->index] + GetEdgeWeight(current_edge);
-					if(alternative < distances[opposite->index])
-					{						
-						prev_index[opposite->index] = current_vertex->index;
-						min_tree.erase(min_tree.find(opposite));
-						distances[opposite->index] = alternative;
-						min_tree.insert(opposite);
+					current_index = current_bucket[cursor++];
+				}
+				else
+				{
+					current_index = zero_queue.top();
+					zero_queue.pop();
+				}
+				if(integer_distances[current_index] != distance) continue;//settled with shorter distance already
+
+				search.settled.push_back(current_index);
+				AML::Vertex<VT, ET>* current_vertex = target_graph->vertex_list[current_index];
+				if(current_vertex == end_vertex) return;
+
+				AML::Edge<VT, ET>* current_edge = current_vertex->GetFront();
+				while(current_edge != nullptr)
+				{
+					const DistanceT weight = DistanceT(GetEdgeWeight(current_edge));
+					if(weight < DistanceT(0) || weight != std::floor(weight)) throw std::invalid_argument("weight is not a non-negative integer");
+
+					AML::Vertex<VT, ET>* opposite = current_edge->GetOpposite(current_vertex);
+					const long long opposite_distance = distance + (long long)weight;
+					if(!search.IsReached(opposite->index) || opposite_distance < integer_distances[opposite->index])
+					{
+						search.Set(opposite->index, DistanceT(opposite_distance), current_index);
+						integer_distances[opposite->index] = opposite_distance;
+						context->prev_edges[opposite->index] = current_edge;
+						if(weight == DistanceT(0))
+						{
+							zero_queue.push(opposite->index);
+						}
+						else
+						{
+							if(weight >= DistanceT(buckets.size()))
+							{
+								//grow buckets, dropping outdated entries
+								std::size_t bucket_number = buckets.size();
+								while(DistanceT(bucket_number) <= weight) bucket_number *= 2;
+								std::vector<std::vector<int>> grown_buckets(bucket_number);
+								queued_number = 0;
+								for(std::size_t slot = 0; slot < buckets.size(); slot++)
+								{
+									//slot keeps the distance in [distance, distance + buckets.size()) which has same remainder
+									const long long slot_distance = distance + ((long long)slot - distance % (long long)buckets.size() + (long long)buckets.size()) % (long long)buckets.size();
+									for(int index : buckets[slot])
+									{
+										if(integer_distances[index] != slot_distance) continue;
+										grown_buckets[std::size_t(slot_distance % (long long)bucket_number)].push_back(index);
+										++queued_number;
+									}
+								}
+								buckets.swap(grown_buckets);
+							}
+							buckets[std::size_t(opposite_distance % (long long)buckets.size())].push_back(opposite->index);
+							++queued_number;
+						}
 					}
+					current_edge = current_edge->GetNext(current_vertex);
 				}
-				current_edge = current_edge->GetNext(current_vertex);
 			}
-			distances[current_vertex->index] = 0.0f;
 		}
+	}
+
+	/**	internal function of Dijkstra with WeightType::Uniform. breadth first search, level by level.
+	*	vertices of a level are settled in order of index, so the result is same as the heap which breaks ties by smaller index.
+	*@param	end_vertex	search stops when it is settled. nullptr to search every reachable vertex.
+	*/
+	template<typename VT, typename ET, typename DistanceT, typename WeightFunctionT>
+	void _BreadthFirstSearch(PathQueryContext<VT, ET, DistanceT>* context,
+							 WeightFunctionT GetEdgeWeight,
+							 AML::Vertex<VT, ET>* start_vertex,
+							 AML::Vertex<VT, ET>* end_vertex)
+	{
+		AML::Graph<VT, ET>* target_graph = context->GetGraph();
+		context->Reset();
+		SearchSpace<DistanceT>& search = context->forward;
+		search.Update(start_vertex->index, DistanceT(0), start_vertex->index);
+		context->prev_edges[start_vertex->index] = nullptr;
 
-		int current_index = prev_index[end_vertex->index];
-		
-		while(current_index != start_vertex->index)
+		//weight of the first edge. every other edge must have same weight
+		DistanceT uniform_weight = DistanceT(0);
+		bool has_uniform_weight = false;
+
+		std::vector<int> current_level(1, start_vertex->index);
+		std::vector<int> next_level;
+		while(!current_level.empty())
 		{
-			result.insert(result.begin(), target_graph->vertex_list[current_index]);
-			current_index = prev_index[current_index];
+			std::sort(current_level.begin(), current_level.end());
+			for(int current_index : current_level)
+			{
+				search.settled.push_back(current_index);
+				AML::Vertex<VT, ET>* current_vertex = target_graph->vertex_list[current_index];
+				if(current_vertex == end_vertex) return;
+
+				const DistanceT current_distance = search.distances[current_index];
+				AML::Edge<VT, ET>* current_edge = current_vertex->GetFront();
+				while(current_edge != nullptr)
+				{
+					const DistanceT weight = DistanceT(GetEdgeWeight(current_edge));
+					if(!has_uniform_weight)
+					{
+						if(!(weight > DistanceT(0))) throw std::invalid_argument("uniform weight is not positive");
+						uniform_weight = weight;
+						has_uniform_weight = true;
+					}
+					else if(weight != uniform_weight) throw std::invalid_argument("weights are not uniform");
+
+					AML::Vertex<VT, ET>* opposite = current_edge->GetOpposite(current_vertex);
+					if(search.Update(opposite->index, current_distance + weight, current_index))
+					{
+						context->prev_edges[opposite->index] = current_edge;
+						next_level.push_back(opposite->index);
+					}
+					current_edge = current_edge->GetNext(current_vertex);
+				}
+			}
+			current_level.swap(next_level);
+			next_level.clear();
+		}
+	}
+
+	template<typename VT, typename ET, typename DistanceT, typename WeightFunctionT>
+	std::vector<AML::Vertex<VT, ET>*> DijkstraAlgorithmPath(PathQueryContext<VT, ET, DistanceT>* context,
+														 WeightFunctionT GetEdgeWeight,
+														 AML::Vertex<VT, ET>* start_vertex,
+														 AML::Vertex<VT, ET>* end_vertex,
+														 WeightType weight_type = WeightType::Real)
+	{
+		std::vector<AML::Vertex<VT, ET>*> result;
+		if(!context->Prepare(start_vertex) || !context->Prepare(end_vertex))
+			return result;//if given vertex isn't in graph
+
+		AML::Graph<VT, ET>* target_graph = context->GetGraph();
+		SearchSpace<DistanceT>& search = context->forward;
+		if(weight_type == WeightType::Integer)
+		{
+			_DialSearch(context, GetEdgeWeight, start_vertex, end_vertex);
+		}
+		else if(weight_type == WeightType::Uniform)
+		{
+			_BreadthFirstSearch(context, GetEdgeWeight, start_vertex, end_vertex);
+		}
+		else
+		{
+			context->Reset();
+			search.Start(start_vertex->index, DistanceT(0));
+
+			while(!search.heap.Empty())
+			{
+				AML::Vertex<VT, ET>* current_vertex = target_graph->vertex_list[search.Settle()];
+				if(current_vertex == end_vertex) break;
+				const DistanceT current_distance = search.distances[current_vertex->index];
+				AML::Edge<VT, ET>* current_edge = current_vertex->GetFront();
+				while(current_edge != nullptr)
+				{
+					AML::Vertex<VT, ET>* opposite = current_edge->GetOpposite(current_vertex);
+					search.Relax(opposite->index, current_distance + DistanceT(GetEdgeWeight(current_edge)), current_vertex->index);
+					current_edge = current_edge->GetNext(current_vertex);
+				}
+			}
+		}
+
+		if(!search.IsReached(end_vertex->index)) return result;
+
+		for(int index : search.GetPath(end_vertex->index))
+		{
+			result.push_back(target_graph->vertex_list[index]);
 		}
 		return result;
-		
+	}
+
+	/**	Dijkstra Algorithm.
+	*@param	GetEdgeWeight	function pointer, lambda or object called as GetEdgeWeight(edge) with (AML::Edge<VT, ET>* &).
+	*						distances have the type of weight it returns. AML::EdgeData() reads the data of edge directly.
+	*@return	vertices between start_vertex and end_vertex
+	*/
+	template<typename VT, typename ET, typename WeightFunctionT>
+	std::vector<AML::Vertex<VT,ET>*> DijkstraAlgorithmPath(AML::Graph<VT, ET> *target_graph,
+														 WeightFunctionT GetEdgeWeight,
+														 AML::Vertex<VT,ET>* start_vertex,
+														 AML::Vertex<VT,ET>* end_vertex,
+														 WeightType weight_type = WeightType::Real)
+	{
+		PathQueryContext<VT, ET, AML::EdgeWeightType<WeightFunctionT, VT, ET>> context(target_graph);
+		return DijkstraAlgorithmPath(&context, GetEdgeWeight, start_vertex, end_vertex, weight_type);
+
 		/**
-		* using std::set as red-black binary search tree
-		* because it's time complexity of (search, insert, delete) is O(logV) and using O(V) of space
-		* 
-		* if we use priority-queue with lazy-deletion, it will take O(logV) of time complexity(but faster than set)
+		* using indexed 4-ary heap with decrease-key (IndexedHeap.h)
+		* time complexity of (push, decrease-key, pop) is O(logV) and it uses O(V) of space
+		*
+		* if we use priority-queue with lazy-deletion, it will take O(logV) of time complexity
 		* but it will need O(E) of space (as the older data tend to have bigger distance, thus they usually doesn't locate on the top of heap.)
-		*	
-		* in most case, people will prefer later one,
-		* but I wanted to use this library for the Networks made of more than 100,000 vertices and 400,000 edges.
+		*
+		* I wanted to use this library for the Networks made of more than 100,000 vertices and 400,000 edges.
 		* in such large case, there could be memory allocation issues
-		* 
-		* if we use custom heap, and rearrange heap after change non-top value, it took O(log V) time with O(V) space
-		* this will faster than std::set, but still have same time-complexity. so I choosed std::set.
+		*
+		* std::set had same time-complexity and space, but every relaxation needed erase and insert of a tree node.
+		* the heap keeps only reached vertices in one contiguous array, and decrease-key only moves the vertex toward the root.
+		*
+		* for repeated queries on same graph, keep a PathQueryContext and pass it instead of the graph.
 		*/
 	}
 
-	template<typename VT, typename ET>
-	std::vector<AML::Edge<VT, ET>*> DijkstraAlgorithmTree(AML::Graph<VT, ET> *target_graph,
-															float (*GetEdgeWeight)(AML::Edge<VT, ET>* &),
-															AML::Vertex<VT, ET>* start_vertex)
+	template<typename VT, typename ET, typename DistanceT, typename WeightFunctionT>
+	std::vector<AML::Edge<VT, ET>*> DijkstraAlgorithmTree(PathQueryContext<VT, ET, DistanceT>* context,
+															WeightFunctionT GetEdgeWeight,
+															AML::Vertex<VT, ET>* start_vertex,
+															WeightType weight_type = WeightType::Real)
 	{
 		std::vector<AML::Edge<VT, ET>*> result;
-		target_graph->ResetVertexIndex();
-		if((target_graph->vertex_list[start_vertex->index] != start_vertex))
+		if(!context->Prepare(start_vertex))
 			return result;//if given vertex isn't in graph
 
-		const int network_size = target_graph->vertex_list.size();
-		result.assign(network_size, nullptr);
-
-		//vector to save distance from start_node if distance is 0.0f, it means that the vertex is already visited or start node.
-		std::vector<float> distances(network_size, std::numeric_limits<float>::max());
-		distances[start_vertex->index] = 0.0f;
-
-		//vector to save index of previous node in shortest path
-		std::vector<AML::Edge<VT, ET>*> prev_path(network_size, nullptr);
-
-		//distance compare function
-		auto comp = [&distances](AML::Vertex<VT, ET>* front, AML::Vertex<VT, ET>* back)
-			-> bool
+		AML::Graph<VT, ET>* target_graph = context->GetGraph();
+		SearchSpace<DistanceT>& search = context->forward;
+		if(weight_type == WeightType::Integer)
 		{
-			float bd = distances[back->index];
-			float fd = distances[front->index];
-			if(bd != fd) return bd > fd;
-			return front->index < back->index;
-		};
+			_DialSearch<VT, ET>(context, GetEdgeWeight, start_vertex, nullptr);
+		}
+		else if(weight_type == WeightType::Uniform)
+		{
+			_BreadthFirstSearch<VT, ET>(context, GetEdgeWeight, start_vertex, nullptr);
+		}
+		else
+		{
+			context->Reset();
+			search.Start(start_vertex->index, DistanceT(0));
+			context->prev_edges[start_vertex->index] = nullptr;
 
-		std::set<AML::Vertex<VT, ET>*, decltype(comp)> min_tree(comp);
+			while(!search.heap.Empty())
+			{
+				AML::Vertex<VT, ET>* current_vertex = target_graph->vertex_list[search.Settle()];
+				const DistanceT current_distance = search.distances[current_vertex->index];
+				AML::Edge<VT, ET>* current_edge = current_vertex->GetFront();
+				while(current_edge != nullptr)
+				{
+					AML::Vertex<VT, ET>* opposite = current_edge->GetOpposite(current_vertex);
+					if(search.Relax(opposite->index, current_distance + DistanceT(GetEdgeWeight(current_edge)), current_vertex->index))
+						context->prev_edges[opposite->index] = current_edge;
+					current_edge = current_edge->GetNext(current_vertex);
+				}
+			}
+		}
 
-		for(AML::Vertex<VT, ET>* vertex : target_graph->vertex_list)
+		result.assign(search.GetSize(), nullptr);
+		for(int index : search.settled)
 		{
-			min_tree.insert(vertex);
+			result[index] = context->prev_edges[index];
 		}
+		return result;
+	}
+
+	template<typename VT, typename ET, typename WeightFunctionT>
+	std::vector<AML::Edge<VT, ET>*> DijkstraAlgorithmTree(AML::Graph<VT, ET> *target_graph,
+															WeightFunctionT GetEdgeWeight,
+															AML::Vertex<VT, ET>* start_vertex,
+															WeightType weight_type = WeightType::Real)
+	{
+		PathQueryContext<VT, ET, AML::EdgeWeightType<WeightFunctionT, VT, ET>> context(target_graph);
+		return DijkstraAlgorithmTree(&context, GetEdgeWeight, start_vertex, weight_type);
+	}
 
-		while(!min_tree.empty())
+	/**	A* Algorithm.
+	*@param	heuristic	function pointer, lambda or object called as heuristic(vertex, end_vertex), which must not overestimate the distance.
+	*					Landmarks can be passed for graphs without coordinates. the estimate is converted to the type of distance.
+	*/
+	template<typename VT, typename ET, typename DistanceT, typename WeightFunctionT, typename HeuristicT>
+	std::vector<AML::Vertex<VT, ET>*> AStarAlgorithm(PathQueryContext<VT, ET, DistanceT>* context,
+													 WeightFunctionT GetEdgeWeight,
+													 const HeuristicT& heuristic,
+													 AML::Vertex<VT, ET>* start_vertex,
+													 AML::Vertex<VT, ET>* end_vertex)
+	{
+		std::vector<AML::Vertex<VT, ET>*> result;
+		if(!context->Prepare(start_vertex) || !context->Prepare(end_vertex))
+			return result;//if given vertex isn't in graph
+
+		AML::Graph<VT, ET>* target_graph = context->GetGraph();
+
+		//distances of search space are evaluations = distance from start_node + heuristic to end_node
+		context->Reset();
+		SearchSpace<DistanceT>& search = context->forward;
+		search.Start(start_vertex->index, DistanceT(heuristic(start_vertex, end_vertex)));
+
+		while(!search.heap.Empty())
 		{
-			typename std::set<AML::Vertex<VT, ET>*, decltype(comp)>::iterator iter = min_tree.begin();
-			AML::Vertex<VT, ET>* current_vertex = *iter;
-			min_tree.erase(iter);
-			if(distances[current_vertex->index] == std::numeric_limits<float>::max()) continue;
+			AML::Vertex<VT, ET>* current_vertex = target_graph->vertex_list[search.Settle()];
+			if(current_vertex == end_vertex) break;
+			const DistanceT current_evaluation = search.distances[current_vertex->index] - DistanceT(heuristic(current_vertex, end_vertex));
 			AML::Edge<VT, ET>* current_edge = current_vertex->GetFront();
 			while(current_edge != nullptr)
 			{
 				AML::Vertex<VT, ET>* opposite = current_edge->GetOpposite(current_vertex);
-				if(distances[opposite->index] > 0.0f)
+				if(!search.IsSettled(opposite->index))
 				{
-					float alternative = distances[current_vertex->index] + GetEdgeWeight(current_edge);
-					if(alternative < distances[opposite->index])
-					{
-						result[opposite->index] = current_edge;
-						min_tree.erase(min_tree.find(opposite));
-						distances[opposite->index] = alternative;
-						min_tree.insert(opposite);
-					}
+					DistanceT alternative = current_evaluation + DistanceT(GetEdgeWeight(current_edge)) + DistanceT(heuristic(opposite, end_vertex));
+					search.Relax(opposite->index, alternative, current_vertex->index);
 				}
 				current_edge = current_edge->GetNext(current_vertex);
 			}
-			distances[current_vertex->index] = 0.0f;
 		}
 
+		if(!search.IsReached(end_vertex->index)) return result;
+
+		for(int index : search.GetPath(end_vertex->index))
+		{
+			result.push_back(target_graph->vertex_list[index]);
+		}
 		return result;
 	}
 
-	template<typename VT, typename ET>
+	template<typename VT, typename ET, typename WeightFunctionT, typename HeuristicT>
 	std::vector<AML::Vertex<VT, ET>*> AStarAlgorithm(AML::Graph<VT, ET> *target_graph,
-													 float (*GetEdgeWeight)(AML::Edge<VT, ET>* &),
-													 float (*heuristic)(AML::Vertex<VT, ET>* &, AML::Vertex<VT, ET>* &),
+													 WeightFunctionT GetEdgeWeight,
+													 const HeuristicT& heuristic,
 													 AML::Vertex<VT, ET>* start_vertex,
 													 AML::Vertex<VT, ET>* end_vertex)
+	{
+		PathQueryContext<VT, ET, AML::EdgeWeightType<WeightFunctionT, VT, ET>> context(target_graph);
+		return AStarAlgorithm(&context, GetEdgeWeight, heuristic, start_vertex, end_vertex);
+	}
+
+	/**	internal function of bidirectional search. runs Dijkstra from both ends on the reduced weights
+	*	w(u, v) - potential(u) + potential(v) of forward, and w(u, v) + potential(u) - potential(v) of backward.
+	*	stops when sum of the top keys of two heaps is not smaller than the shortest path found.
+	*@return	vertices between start_vertex and end_vertex
+	*/
+	template<typename VT, typename ET, typename DistanceT, typename WeightFunctionT, typename PotentialT>
+	std::vector<AML::Vertex<VT, ET>*> _BidirectionalSearch(PathQueryContext<VT, ET, DistanceT>* context,
+														  WeightFunctionT GetEdgeWeight,
+														  PotentialT potential,
+														  AML::Vertex<VT, ET>* start_vertex,
+														  AML::Vertex<VT, ET>* end_vertex)
 	{
 		std::vector<AML::Vertex<VT, ET>*> result;
-		target_graph->ResetVertexIndex();
-		if((target_graph->vertex_list[start_vertex->index] != start_vertex) || (target_graph->vertex_list[end_vertex->index] != end_vertex))
+		if(!context->Prepare(start_vertex) || !context->Prepare(end_vertex))
 			return result;//if given vertex isn't in graph
 
-		const int network_size = target_graph->vertex_list.size();
+		if(start_vertex == end_vertex) return result;
 
-		//vector to save distance from start_node if distance is 0.0f, it means that the vertex is already visited or start node.
-		std::vector<float> evaluations(network_size, std::numeric_limits<float>::max());
-		evaluations[start_vertex->index] = heuristic(start_vertex, end_vertex);
+		AML::Graph<VT, ET>* target_graph = context->GetGraph();
+		context->Reset();
+		SearchSpace<DistanceT>& forward = context->forward;
+		SearchSpace<DistanceT>& backward = context->backward;
+		forward.Start(start_vertex->index, DistanceT(0));
+		backward.Start(end_vertex->index, DistanceT(0));
 
-		//vector to save index of previous node in shortest path
-		std::vector<int> prev_index(network_size, -1);
-		prev_index[start_vertex->index] = start_vertex->index;
+		//shortest path found so far, in reduced weight, and the vertex where two searches met on it
+		DistanceT best_distance = std::numeric_limits<DistanceT>::max();
+		int meeting_index = -1;
 
-		//distance compare function
-		auto comp = [&evaluations](AML::Vertex<VT, ET>* front, AML::Vertex<VT, ET>* back)
-			-> bool
+		while(!forward.heap.Empty() && !backward.heap.Empty())
 		{
-			float bd = evaluations[back->index];
-			float fd = evaluations[front->index];
-			if(bd != fd) return bd > fd;
-			return front->index < back->index;
-		};
-
-		std::set<AML::Vertex<VT, ET>*, decltype(comp)> min_tree(comp);
+			if(forward.heap.TopKey() + backward.heap.TopKey() >= best_distance) break;
 
-		for(AML::Vertex<VT, ET>* vertex : target_graph->vertex_list)
-		{
-			min_tree.insert(vertex);
-		}
+			//expand the side with smaller frontier
+			const bool is_forward = forward.heap.Size() <= backward.heap.Size();
+			SearchSpace<DistanceT>& current_search = is_forward ? forward : backward;
+			SearchSpace<DistanceT>& other_search = is_forward ? backward : forward;
 
-		while(!min_tree.empty())
-		{
-			typename std::set<AML::Vertex<VT, ET>*, decltype(comp)>::iterator iter = min_tree.begin();
-			AML::Vertex<VT, ET>* current_vertex = *iter;
-			min_tree.erase(iter);
-			if(current_vertex == end_vertex) break;
+			AML::Vertex<VT, ET>* current_vertex = target_graph->vertex_list[current_search.Settle()];
+			const DistanceT current_distance = current_search.distances[current_vertex->index];
+			const DistanceT current_potential = potential(current_vertex);
 			AML::Edge<VT, ET>* current_edge = current_vertex->GetFront();
 			while(current_edge != nullptr)
 			{
 				AML::Vertex<VT, ET>* opposite = current_edge->GetOpposite(current_vertex);
-				if(evaluations[opposite->index] >= 0.0f)
+				const int opposite_index = opposite->index;
+				if(!current_search.IsSettled(opposite_index))
+				{
+					const DistanceT opposite_potential = potential(opposite);
+					DistanceT reduced_weight = DistanceT(GetEdgeWeight(current_edge))
+						+ (is_forward ? opposite_potential - current_potential : current_potential - opposite_potential);
+					current_search.Relax(opposite_index, current_distance + reduced_weight, current_vertex->index);
+				}
+				if(other_search.IsReached(opposite_index) && current_search.IsReached(opposite_index))
 				{
-					float alternative = evaluations[current_vertex->index] + GetEdgeWeight(current_edge) - heuristic(current_vertex, end_vertex) + heuristic(opposite, end_vertex);
-					if(alternative < evaluations[opposite->index])
+					DistanceT candidate = current_search.distances[opposite_index] + other_search.distances[opposite_index];
+					if(candidate < best_distance)
 					{
-						prev_index[opposite->index] = current_vertex->index;
-						min_tree.erase(min_tree.find(opposite));
-						evaluations[opposite->index] = alternative;
-						min_tree.insert(opposite);
+						best_distance = candidate;
+						meeting_index = opposite_index;
 					}
 				}
 				current_edge = current_edge->GetNext(current_vertex);
 			}
-			evaluations[current_vertex->index] = -2.0f;
 		}
 
-		int current_index = prev_index[end_vertex->index];
+		if(meeting_index == -1) return result;
+
+		//start ... meeting vertex from forward, meeting vertex ... end from backward
+		for(int index : forward.GetPath(meeting_index))
+		{
+			result.push_back(target_graph->vertex_list[index]);
+		}
+		if(meeting_index != start_vertex->index && meeting_index != end_vertex->index)
+		{
+			result.push_back(target_graph->vertex_list[meeting_index]);
+		}
+		std::vector<int> backward_path = backward.GetPath(meeting_index);
+		for(auto iter = backward_path.rbegin(); iter != backward_path.rend(); ++iter)
+		{
+			result.push_back(target_graph->vertex_list[*iter]);
+		}
+		return result;
+	}
+
+	/**	Bidirectional Dijkstra Algorithm. searches from start_vertex and end_vertex at the same time,
+	*	and usually settles far fewer vertices than DijkstraAlgorithmPath.
+	*@return	same as DijkstraAlgorithmPath. vertices between start_vertex and end_vertex
+	*@note	the graph is undirected, so the backward search uses same weights.
+	*/
+	template<typename VT, typename ET, typename DistanceT, typename WeightFunctionT>
+	std::vector<AML::Vertex<VT, ET>*> BidirectionalDijkstraPath(PathQueryContext<VT, ET, DistanceT>* context,
+															   WeightFunctionT GetEdgeWeight,
+															   AML::Vertex<VT, ET>* start_vertex,
+															   AML::Vertex<VT, ET>* end_vertex)
+	{
+		return _BidirectionalSearch(context, GetEdgeWeight, [](AML::Vertex<VT, ET>*)->DistanceT{ return DistanceT(0); }, start_vertex, end_vertex);
+	}
+
+	template<typename VT, typename ET, typename WeightFunctionT>
+	std::vector<AML::Vertex<VT, ET>*> BidirectionalDijkstraPath(AML::Graph<VT, ET> *target_graph,
+															   WeightFunctionT GetEdgeWeight,
+															   AML::Vertex<VT, ET>* start_vertex,
+															   AML::Vertex<VT, ET>* end_vertex)
+	{
+		PathQueryContext<VT, ET, AML::EdgeWeightType<WeightFunctionT, VT, ET>> context(target_graph);
+		return BidirectionalDijkstraPath(&context, GetEdgeWeight, start_vertex, end_vertex);
+	}
+
+	/**	Bidirectional A* Algorithm with average potential (heuristic(v, end) - heuristic(v, start)) / 2.
+	*@return	same as AStarAlgorithm. vertices between start_vertex and end_vertex
+	*@note	heuristic must be consistent, heuristic(u, x) <= w(u, v) + heuristic(v, x) for every edge (u, v).
+	*		otherwise the result may not be the shortest. the potential is converted to the type of distance,
+	*		so with integer weights the heuristic should return even integers to stay consistent.
+	*/
+	template<typename VT, typename ET, typename DistanceT, typename WeightFunctionT, typename HeuristicT>
+	std::vector<AML::Vertex<VT, ET>*> BidirectionalAStarAlgorithm(PathQueryContext<VT, ET, DistanceT>* context,
+																 WeightFunctionT GetEdgeWeight,
+																 const HeuristicT& heuristic,
+																 AML::Vertex<VT, ET>* start_vertex,
+																 AML::Vertex<VT, ET>* end_vertex)
+	{
+		auto potential = [&heuristic, start_vertex, end_vertex](AML::Vertex<VT, ET>* vertex)->DistanceT
+		{
+			AML::Vertex<VT, ET>* start = start_vertex;
+			AML::Vertex<VT, ET>* end = end_vertex;
+			return DistanceT((heuristic(vertex, end) - heuristic(vertex, start)) / 2);
+		};
+		return _BidirectionalSearch(context, GetEdgeWeight, potential, start_vertex, end_vertex);
+	}
+
+	template<typename VT, typename ET, typename WeightFunctionT, typename HeuristicT>
+	std::vector<AML::Vertex<VT, ET>*> BidirectionalAStarAlgorithm(AML::Graph<VT, ET> *target_graph,
+																 WeightFunctionT GetEdgeWeight,
+																 const HeuristicT& heuristic,
+																 AML::Vertex<VT, ET>* start_vertex,
+																 AML::Vertex<VT, ET>* end_vertex)
+	{
+		PathQueryContext<VT, ET, AML::EdgeWeightType<WeightFunctionT, VT, ET>> context(target_graph);
+		return BidirectionalAStarAlgorithm(&context, GetEdgeWeight, heuristic, start_vertex, end_vertex);
+	}
+
+	/**	internal function of the Compressed Sparse Row overloads. returns workspace if it is given, or local_search.
+	*	the buffers are resized for target_graph and reset.
+	*/
+	template<typename VT, typename ET, typename WeightT>
+	SearchSpace<WeightT>& _PrepareSearchSpace(const AML::CompressedGraph<VT, ET, WeightT> *target_graph, SearchSpace<WeightT>* workspace, SearchSpace<WeightT>& local_search)
+	{
+		SearchSpace<WeightT>& search = (workspace != nullptr) ? *workspace : local_search;
+		if(search.GetSize() != target_graph->GetVertexNumber()) search.Initialize(target_graph->GetVertexNumber());
+		else search.Reset();
+		return search;
+	}
+
+	/**	Dijkstra Algorithm on the Compressed Sparse Row snapshot of graph. weights are taken from the snapshot.
+	*	the snapshot is only read, so several threads can search it at once with their own workspaces.
+	*@param	workspace	buffers reused between calls. nullptr allocates them for this call only.
+	*@return	same as DijkstraAlgorithmPath of Graph. vertices between start_vertex and end_vertex
+	*/
+	template<typename VT, typename ET, typename WeightT>
+	std::vector<AML::Vertex<VT, ET>*> DijkstraAlgorithmPath(const AML::CompressedGraph<VT, ET, WeightT> *target_graph,
+														 AML::Vertex<VT, ET>* start_vertex,
+														 AML::Vertex<VT, ET>* end_vertex,
+														 SearchSpace<WeightT>* workspace = nullptr)
+	{
+		std::vector<AML::Vertex<VT, ET>*> result;
+		if(!target_graph->Contains(start_vertex) || !target_graph->Contains(end_vertex))
+			return result;//if given vertex isn't in graph
+
+		const int end_index = end_vertex->index;
+
+		SearchSpace<WeightT> local_search;
+		SearchSpace<WeightT>& search = _PrepareSearchSpace(target_graph, workspace, local_search);
+		search.Start(start_vertex->index, WeightT(0));
+
+		while(!search.heap.Empty())
+		{
+			int current = search.Settle();
+			if(current == end_index) break;
+			const WeightT current_distance = search.distances[current];
+			for(int i = target_graph->offsets[current]; i < target_graph->offsets[current + 1]; i++)
+			{
+				search.Relax(target_graph->neighbors[i], current_distance + target_graph->weights[i], current);
+			}
+		}
+
+		if(!search.IsReached(end_index)) return result;
+
+		for(int index : search.GetPath(end_index))
+		{
+			result.push_back(target_graph->vertex_list[index]);
+		}
+		return result;
+	}
+
+	/**	Dijkstra Algorithm on the Compressed Sparse Row snapshot of graph. weights are taken from the snapshot.
+	*@param	workspace	buffers reused between calls. nullptr allocates them for this call only.
+	*@return	same as DijkstraAlgorithmTree of Graph. edge to previous vertex of each vertex index, nullptr for start and unreachable vertices.
+	*/
+	template<typename VT, typename ET, typename WeightT>
+	std::vector<AML::Edge<VT, ET>*> DijkstraAlgorithmTree(const AML::CompressedGraph<VT, ET, WeightT> *target_graph,
+															AML::Vertex<VT, ET>* start_vertex,
+															SearchSpace<WeightT>* workspace = nullptr)
+	{
+		std::vector<AML::Edge<VT, ET>*> result;
+		if(!target_graph->Contains(start_vertex))
+			return result;//if given vertex isn't in graph
+
+		result.assign(target_graph->GetVertexNumber(), nullptr);
+
+		SearchSpace<WeightT> local_search;
+		SearchSpace<WeightT>& search = _PrepareSearchSpace(target_graph, workspace, local_search);
+		search.Start(start_vertex->index, WeightT(0));
+
+		while(!search.heap.Empty())
+		{
+			int current = search.Settle();
+			const WeightT current_distance = search.distances[current];
+			for(int i = target_graph->offsets[current]; i < target_graph->offsets[current + 1]; i++)
+			{
+				int opposite = target_graph->neighbors[i];
+				if(search.Relax(opposite, current_distance + target_graph->weights[i], current))
+					result[opposite] = target_graph->edge_list[target_graph->edge_ids[i]];
+			}
+		}
+
+		return result;
+	}
+
+	/**	A* Algorithm on the Compressed Sparse Row snapshot of graph. weights are taken from the snapshot.
+	*@return	same as AStarAlgorithm of Graph. vertices between start_vertex and end_vertex
+	*/
+	template<typename VT, typename ET, typename WeightT, typename HeuristicT>
+	std::vector<AML::Vertex<VT, ET>*> AStarAlgorithm(const AML::CompressedGraph<VT, ET, WeightT> *target_graph,
+													 const HeuristicT& heuristic,
+													 AML::Vertex<VT, ET>* start_vertex,
+													 AML::Vertex<VT, ET>* end_vertex)
+	{
+		std::vector<AML::Vertex<VT, ET>*> result;
+		if(!target_graph->Contains(start_vertex) || !target_graph->Contains(end_vertex))
+			return result;//if given vertex isn't in graph
+
+		const int end_index = end_vertex->index;
+
+		//distances of search space are evaluations = distance from start + heuristic to end
+		SearchSpace<WeightT> search(target_graph->GetVertexNumber());
+		search.Start(start_vertex->index, WeightT(heuristic(start_vertex, end_vertex)));
+
+		while(!search.heap.Empty())
+		{
+			int current = search.Settle();
+			if(current == end_index) break;
+			AML::Vertex<VT, ET>* current_vertex = target_graph->vertex_list[current];
+			const WeightT current_evaluation = search.distances[current] - WeightT(heuristic(current_vertex, end_vertex));
+			for(int i = target_graph->offsets[current]; i < target_graph->offsets[current + 1]; i++)
+			{
+				int opposite = target_graph->neighbors[i];
+				if(search.IsSettled(opposite)) continue;
+				AML::Vertex<VT, ET>* opposite_vertex = target_graph->vertex_list[opposite];
+				search.Relax(opposite, current_evaluation + target_graph->weights[i] + WeightT(heuristic(opposite_vertex, end_vertex)), current);
+			}
+		}
 
-		if(current_index == -1) return result;
+		if(!search.IsReached(end_index)) return result;
 
-		while(current_index != start_vertex->index)
+		for(int index : search.GetPath(end_index))
 		{
-			result.insert(result.begin(), target_graph->vertex_list[current_index]);
-			current_index = prev_index[current_index];
+			result.push_back(target_graph->vertex_list[index]);
 		}
 		return result;
 	}
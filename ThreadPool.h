@@ -0,0 +1,265 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+#include <utility>
+
+/**	Work-stealing thread pool.
+*	every worker has its own task queue. a worker takes its newest task first, and steals the oldest task of other workers when its queue is empty.
+*	tasks submitted from outside of the pool are spread over the workers in turn, and tasks submitted by a worker go to its own queue.
+*	each task gets the id of the worker running it, in [0, GetThreadNumber()), so it can use per-worker buffers without locking.
+*/
+class ThreadPool
+{
+protected:
+	struct Worker
+	{
+		std::mutex mutex;
+		std::deque<std::function<void(int)>> tasks;
+	};
+
+	std::vector<std::unique_ptr<Worker>> workers;
+
+	std::vector<std::thread> threads;
+
+	std::mutex sleep_mutex;
+
+	//wakes sleeping workers when a task is submitted or the pool is stopping
+	std::condition_variable sleep_condition;
+
+	//wakes Wait when every task is done
+	std::condition_variable idle_condition;
+
+	//tasks in queues
+	std::atomic<int> queued_number{0};
+
+	//tasks submitted and not finished yet
+	std::atomic<int> pending_number{0};
+
+	std::atomic<unsigned int> next_worker{0};
+
+	//exception thrown by a task, rethrown by Wait. guarded by sleep_mutex
+	std::exception_ptr task_exception;
+
+	bool stopping = false;
+
+public:
+	/**@param	thread_number	number of workers. 0 uses std::thread::hardware_concurrency()
+	*/
+	ThreadPool(int thread_number = 0)
+	{
+		if(thread_number <= 0) thread_number = int(std::thread::hardware_concurrency());
+		if(thread_number <= 0) thread_number = 1;
+		for(int i = 0; i < thread_number; i++)
+		{
+			workers.emplace_back(new Worker());
+		}
+		for(int i = 0; i < thread_number; i++)
+		{
+			threads.emplace_back(&ThreadPool::Run, this, i);
+		}
+	}
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	/**	tasks already submitted are finished before the workers are joined
+	*/
+	~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(sleep_mutex);
+			stopping = true;
+		}
+		sleep_condition.notify_all();
+		for(std::thread& thread : threads)
+		{
+			thread.join();
+		}
+	}
+
+	int GetThreadNumber() const { return int(workers.size()); }
+
+	/**	add task to the pool
+	*@param	task	called as task(worker_id) on a worker thread
+	*/
+	void Submit(std::function<void(int)> task)
+	{
+		int worker_id = GetCurrentWorker();
+		if(worker_id == -1) worker_id = int(next_worker.fetch_add(1, std::memory_order_relaxed) % workers.size());
+
+		pending_number.fetch_add(1);
+		{
+			std::lock_guard<std::mutex> lock(workers[worker_id]->mutex);
+			workers[worker_id]->tasks.push_back(std::move(task));
+		}
+		queued_number.fetch_add(1);
+		{
+			std::lock_guard<std::mutex> lock(sleep_mutex);
+		}
+		sleep_condition.notify_one();
+	}
+
+	/**	block until every submitted task is finished, and rethrow the first exception thrown by them.
+	*@note	must not be called by a task of this pool
+	*/
+	void Wait()
+	{
+		std::unique_lock<std::mutex> lock(sleep_mutex);
+		idle_condition.wait(lock, [this]{ return pending_number.load() == 0; });
+		if(task_exception)
+		{
+			std::exception_ptr exception = task_exception;
+			task_exception = nullptr;
+			std::rethrow_exception(exception);
+		}
+	}
+
+	/**	id of the worker of this pool running on the calling thread
+	*@return	-1 if called outside of the workers of this pool
+	*/
+	int GetCurrentWorker() const
+	{
+		const std::pair<const ThreadPool*, int>& current = CurrentWorker();
+		return (current.first == this) ? current.second : -1;
+	}
+
+protected:
+	static std::pair<const ThreadPool*, int>& CurrentWorker()
+	{
+		static thread_local std::pair<const ThreadPool*, int> current(nullptr, -1);
+		return current;
+	}
+
+	bool PopTask(int worker_id, std::function<void(int)>& task)
+	{
+		//own queue from the back
+		{
+			Worker& worker = *workers[worker_id];
+			std::lock_guard<std::mutex> lock(worker.mutex);
+			if(!worker.tasks.empty())
+			{
+				task = std::move(worker.tasks.back());
+				worker.tasks.pop_back();
+				queued_number.fetch_sub(1);
+				return true;
+			}
+		}
+		//other queues from the front
+		const int worker_number = int(workers.size());
+		for(int i = 1; i < worker_number; i++)
+		{
+			Worker& victim = *workers[(worker_id + i) % worker_number];
+			std::lock_guard<std::mutex> lock(victim.mutex);
+			if(!victim.tasks.empty())
+			{
+				task = std::move(victim.tasks.front());
+				victim.tasks.pop_front();
+				queued_number.fetch_sub(1);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void Run(int worker_id)
+	{
+		CurrentWorker() = std::make_pair(static_cast<const ThreadPool*>(this), worker_id);
+		std::function<void(int)> task;
+		while(true)
+		{
+			if(PopTask(worker_id, task))
+			{
+				try
+				{
+					task(worker_id);
+				}
+				catch(...)
+				{
+					std::lock_guard<std::mutex> lock(sleep_mutex);
+					if(!task_exception) task_exception = std::current_exception();
+				}
+				task = nullptr;
+				if(pending_number.fetch_sub(1) == 1)
+				{
+					std::lock_guard<std::mutex> lock(sleep_mutex);
+					idle_condition.notify_all();
+				}
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(sleep_mutex);
+			sleep_condition.wait(lock, [this]{ return stopping || queued_number.load() > 0; });
+			if(stopping && queued_number.load() == 0) return;
+		}
+	}
+};
+
+/**	loops shorter than this are run by one thread, as starting threads costs more than the loop.
+*	callers of ForEachChunk pass chunk_number 1 under it
+*/
+const int parallel_threshold = 1 << 14;
+
+/**	split [0, size) into chunk_number chunks, and call Function(chunk, begin, end) for each chunk on its own std::thread.
+*	chunk 0 runs on the calling thread. for short loops which are not worth the tasks of a pool.
+*/
+template<typename FunctionT>
+void ForEachChunk(int chunk_number, int size, FunctionT Function)
+{
+	std::vector<std::thread> threads;
+	for(int chunk = 1; chunk < chunk_number; chunk++)
+	{
+		threads.emplace_back(Function, chunk, int((long long)size * chunk / chunk_number), int((long long)size * (chunk + 1) / chunk_number));
+	}
+	Function(0, 0, int((long long)size / chunk_number));
+	for(std::thread& thread : threads)
+	{
+		thread.join();
+	}
+}
+
+/**	submit (task_number) tasks to pool and block until all of them are finished.
+*	Task is called as Task(task_index, workspace) on a worker, with the workspace of that worker.
+*@tparam	WorkspaceT	buffers of a worker, default constructed once per worker and reused by every task it runs
+*@note	rethrows the first exception of the tasks after all of them are finished. must not be called by a task of the same pool.
+*/
+template<typename WorkspaceT, typename TaskT>
+void RunWithWorkspaces(ThreadPool& pool, int task_number, TaskT Task)
+{
+	std::vector<WorkspaceT> workspaces(pool.GetThreadNumber());
+
+	std::mutex batch_mutex;
+	std::condition_variable batch_condition;
+	int remaining_number = task_number;
+	std::exception_ptr batch_exception;
+
+	for(int i = 0; i < task_number; i++)
+	{
+		pool.Submit([&, i](int worker_id)
+		{
+			std::exception_ptr exception;
+			try
+			{
+				Task(i, workspaces[worker_id]);
+			}
+			catch(...)
+			{
+				exception = std::current_exception();
+			}
+			std::lock_guard<std::mutex> lock(batch_mutex);
+			if(exception && !batch_exception) batch_exception = exception;
+			if(--remaining_number == 0) batch_condition.notify_all();
+		});
+	}
+
+	std::unique_lock<std::mutex> lock(batch_mutex);
+	batch_condition.wait(lock, [&remaining_number]{ return remaining_number == 0; });
+	if(batch_exception) std::rethrow_exception(batch_exception);
+}
@@ -1,12 +1,21 @@
 #pragma once
 
 #include <vector>
+#include <atomic>
+#include <utility>
 
+/**	Union-find tree with union by size and path halving.
+*	every operation takes nearly constant amortized time, so long chains are never built even when sets are merged in bad order.
+*/
 class UnionFindTree
 {
 public:
+	//parent of each element. a root is its own parent
 	std::vector<int> vec;
 
+	//number of elements in the set of each root. not meaningful for other elements
+	std::vector<int> sizes;
+
 public:
 	UnionFindTree(){}
 
@@ -17,26 +26,53 @@ public:
 
 	void Initialize(int size)
 	{
-		if(size <= 0) return;
-		vec.clear();		
-		vec.reserve(size);
-		for(int i = 0; i < size; i++)
-		{
-			vec.push_back(i);
-		}
+		if(size < 0) size = 0;
+		vec.resize(size);
+		sizes.resize(size);
+		Reset();
 	}
 
 	void Reset()
 	{
-		for(int i = 0; i < vec.size(); i++)
+		for(int i = 0; i < int(vec.size()); i++)
 		{
 			vec[i] = i;
+			sizes[i] = 1;
 		}
 	}
 
+	int GetSize() const { return int(vec.size()); }
+
+	/**	root of the set containing index. every element on the way is linked to its grandparent.
+	*@return	-1 if index is out of range
+	*/
 	int Find(int index)
 	{
-		if(index < 0 || index >= vec.size()) return -1;
+		if(index < 0 || index >= int(vec.size())) return -1;
+		while(index != vec[index])
+		{
+			vec[index] = vec[vec[index]];
+			index = vec[index];
+		}
+		return index;
+	}
+
+	/**	roots of many elements at once. roots[i] is Find(indices[i])
+	*/
+	void Find(const std::vector<int>& indices, std::vector<int>& roots)
+	{
+		roots.resize(indices.size());
+		for(std::size_t i = 0; i < indices.size(); i++)
+		{
+			roots[i] = Find(indices[i]);
+		}
+	}
+
+	/**	same as Find, but the tree is not changed. several threads can call it together while nobody calls Find or Union.
+	*/
+	int FindRoot(int index) const
+	{
+		if(index < 0 || index >= int(vec.size())) return -1;
 		while(index != vec[index])
 		{
 			index = vec[index];
@@ -44,13 +80,119 @@ public:
 		return index;
 	}
 
+	/**	merge the sets of x and y. the root of the smaller set is linked under the other root, and the root of x is kept when the sizes are same.
+	*@return	true if x and y were in different sets
+	*/
 	bool Union(int x, int y)
 	{
 		int x_root = Find(x);
 		int y_root = Find(y);
-		if(x == -1 || y == -1) return false;
-		bool result = x_root != y_root;
-		if(result) vec[y_root] = x_root;
-		return result;
+		if(x_root == -1 || y_root == -1) return false;
+		if(x_root == y_root) return false;
+		if(sizes[x_root] < sizes[y_root]) std::swap(x_root, y_root);
+		vec[y_root] = x_root;
+		sizes[x_root] += sizes[y_root];
+		return true;
+	}
+
+	bool SameSet(int x, int y)
+	{
+		int x_root = Find(x);
+		return x_root != -1 && x_root == Find(y);
+	}
+
+	//number of elements in the set containing index. 0 if index is out of range
+	int GetSetSize(int index)
+	{
+		int root = Find(index);
+		return root == -1 ? 0 : sizes[root];
+	}
+};
+
+/**	Union-find tree which several threads can Find and Union at the same time without locks.
+*	parents are atomic, Find halves the path with compare-and-swap, and Union links the root of bigger index under the other root,
+*	so a link never makes a cycle. each merge of two sets is reported by exactly one successful Union.
+*/
+class ConcurrentUnionFindTree
+{
+public:
+	std::vector<std::atomic<int>> parents;
+
+public:
+	ConcurrentUnionFindTree(){}
+
+	ConcurrentUnionFindTree(int size)
+	{
+		Initialize(size);
+	}
+
+	void Initialize(int size)
+	{
+		if(size < 0) size = 0;
+		parents = std::vector<std::atomic<int>>(size);
+		Reset();
+	}
+
+	//not thread safe
+	void Reset()
+	{
+		for(int i = 0; i < int(parents.size()); i++)
+		{
+			parents[i].store(i, std::memory_order_relaxed);
+		}
+	}
+
+	int GetSize() const { return int(parents.size()); }
+
+	int Find(int index)
+	{
+		if(index < 0 || index >= int(parents.size())) return -1;
+		while(true)
+		{
+			int parent = parents[index].load(std::memory_order_acquire);
+			if(parent == index) return index;
+			int grandparent = parents[parent].load(std::memory_order_acquire);
+			if(parent != grandparent) parents[index].compare_exchange_weak(parent, grandparent, std::memory_order_release, std::memory_order_relaxed);
+			index = grandparent;
+		}
+	}
+
+	/**	roots of many elements at once. roots[i] is Find(indices[i]). the calls are not atomic as a whole
+	*/
+	void Find(const std::vector<int>& indices, std::vector<int>& roots)
+	{
+		roots.resize(indices.size());
+		for(std::size_t i = 0; i < indices.size(); i++)
+		{
+			roots[i] = Find(indices[i]);
+		}
+	}
+
+	/**@return	true if x and y were in different sets, and this call merged them
+	*/
+	bool Union(int x, int y)
+	{
+		if(x < 0 || x >= int(parents.size()) || y < 0 || y >= int(parents.size())) return false;
+		while(true)
+		{
+			x = Find(x);
+			y = Find(y);
+			if(x == y) return false;
+			if(x < y) std::swap(x, y);
+			int expected = x;
+			if(parents[x].compare_exchange_strong(expected, y, std::memory_order_acq_rel, std::memory_order_relaxed)) return true;
+		}
+	}
+
+	bool SameSet(int x, int y)
+	{
+		while(true)
+		{
+			x = Find(x);
+			y = Find(y);
+			if(x == y) return true;
+			//x may have been linked while y was found
+			if(parents[x].load(std::memory_order_acquire) == x) return false;
+		}
 	}
-};
\ No newline at end of file
+};
@@ -11,6 +11,14 @@
 #include "MinimumSpanningTree.h"
 #include "BenchMark.h"
 #include "ShortestPath.h"
+#include "ContractionHierarchy.h"
+#include "Landmarks.h"
+#include "ParallelShortestPath.h"
+#include "Ensemble.h"
+#include "Percolation.h"
+#include "Robustness.h"
+#include "BreadthFirstSearch.h"
+#include "Centrality.h"
 
 namespace Test
 {
@@ -23,14 +31,6 @@ namespace Test
 
     void TestClustering();
 
-    // 忡 ư ԼԴϴ.
-    void ThreadBADegreeDistribution(int thread_id,
-                                    std::size_t node_number,
-                                    std::size_t connection_per_step,
-                                    std::size_t loop_time,
-                                    std::mutex &cout_mutex,
-                                    std::promise<std::vector<double>> result_promise);
-
     /** Ƽ   BAƮũ Degree Distribution ϴ ԼԴϴ.
     */
     void TestMultiThreadDegreeDistribution();
@@ -45,6 +45,74 @@ namespace Test
     */
     void TestKruskalAlgorithm(int network_size, int connection_step);
 
+    /** Compare the algorithms on Graph and on its CompressedGraph snapshot with BA Network graph.
+    */
+    void TestCompressedGraph(int network_size, int connection_step);
+
+    /** Compare repeated shortest path queries with and without PathQueryContext on BA Network graph.
+    */
+    void TestPathQueryContext(int network_size, int connection_step, int query_number);
+
+    /** Compare settled vertices of Dijkstra and Bidirectional Dijkstra on BA Network graph.
+    */
+    void TestBidirectionalDijkstra(int network_size, int connection_step, int query_number);
+
+    /** Build Contraction Hierarchies on Lattice Network graph and on BA Network graph, and compare their queries with Dijkstra.
+    *   prints the build time, which grows fast on BA Network if the dense core is contracted as well.
+    */
+    void TestContractionHierarchy(int x_size, int y_size, int network_size, int connection_step, int query_number);
+
+    /** Compare settled vertices of Dijkstra and A* with landmark heuristic on BA Network graph.
+    */
+    void TestLandmarks(int network_size, int connection_step, int landmark_number, int query_number);
+
+    /** Compare time and distances of DijkstraAlgorithmTree and DeltaSteppingTree on BA Network graph.
+    */
+    void TestDeltaStepping(int network_size, int connection_step, int thread_number);
+
+    /** Compare shortest path trees from many sources, by a loop and by MultiSourceDijkstraTree on ThreadPool.
+    */
+    void TestMultiSourceDijkstra(int network_size, int connection_step, int source_number, int thread_number);
+
+    /** Compare Kruskal and parallel Boruvka on ER Network graph, which may have several clusters.
+    */
+    void TestBoruvkaAlgorithm(int network_size, int mean_degree, int thread_number);
+
+    /** Compare the sets of UnionFindTree and of ConcurrentUnionFindTree merged by thread_number threads, after same random unions.
+    */
+    void TestUnionFindTree(int size, int union_number, int thread_number);
+
+    /** Compare ER Network G(n, p) made by one thread and by thread_number threads with same seed, and print the edge counts of G(n, p) and G(n, m).
+    */
+    void TestERNetwork(int network_size, int mean_degree, int thread_number);
+
+    /** Compare component ids of ConnectedComponents on ER Network graph by one thread, by thread_number threads and on CompressedGraph.
+    */
+    void TestConnectedComponents(int network_size, int mean_degree, int thread_number);
+
+    /** Largest cluster of bond and site percolation on ER Network graph by NewmanZiff.
+    *   with everything occupied, both curves must end at the clusters of ConnectedComponents, and the largest cluster never shrinks on the way.
+    */
+    void TestPercolation(int network_size, int mean_degree);
+
+    /** Remove vertices of BA Network by random failure and by attacks, and print the largest cluster while they are removed.
+    */
+    void TestAttack(int network_size, int connection_step);
+
+    /** Compare breadth first search of DijkstraAlgorithmTree on Graph with direction-optimizing BreadthFirstSearch on CompressedGraph.
+    */
+    void TestBreadthFirstSearch(int network_size, int connection_step, int thread_number);
+
+    /** Closeness, eccentricity and diameter of BA Network and of sparse ER Network with many clusters by MS-BFS,
+    *   compared with one BreadthFirstSearch per vertex.
+    */
+    void TestCentrality(int network_size, int connection_step, int thread_number);
+
+    /** Compare WeightType::Integer with the heap on BA Network with integer weights, zero weights and weights which grow the buckets,
+    *   and on a chain whose distances are past 2^24, where float can't hold every integer.
+    */
+    void TestIntegerWeight(int network_size, int connection_step);
+
 #pragma endregion Decalre functions
 
 #pragma region Definition
@@ -153,109 +221,62 @@ namespace Test
         }
     }
 
-    // 忡 ư ԼԴϴ.
-    void ThreadBADegreeDistribution(int thread_id,
-                                    std::size_t node_number,
-                                    std::size_t connection_per_step,
-                                    std::size_t loop_time,
-                                    std::mutex &cout_mutex,
-                                    std::promise<std::vector<double>> result_promise)
-    {
-        cout_mutex.lock();
-        std::cout << "thread " << thread_id << " started\n";
-        cout_mutex.unlock();
-
-        std::chrono::time_point<std::chrono::high_resolution_clock> start_point
-            = std::chrono::high_resolution_clock::now();
-
-        namespace AML = AdjacencyMultiList;
-        AML::Graph<int, float> network(node_number);
-        network.Initialize(node_number);
-
-        std::vector<int> degree_count;
-        degree_count.reserve(node_number);
-
-        std::vector<double> degree_distribution(node_number, 0.0);
-
-        for(std::size_t i = 0; i < loop_time; i++)
-        {
-            Network::ConnectBANetwork(&network, connection_per_step);
-            degree_count.assign(node_number, 0);
-            for(AML::Vertex<int, float>* vertex : network.vertex_list)
-            {
-                degree_count[vertex->GetDegree()] += 1;
-            }
-            for(std::size_t i = 0; i < node_number; i++)
-            {
-                degree_distribution[i] += (double(degree_count[i]) / node_number) / loop_time;
-            }
-            network.ClearEdge();
-            degree_count.clear();
-
-            cout_mutex.lock();
-            std::cout << "thread " << thread_id << " loop " << i << " ended\n";
-            cout_mutex.unlock();
-        }
-        result_promise.set_value(degree_distribution);
-        network.ClearVertex();
-
-        std::chrono::time_point<std::chrono::high_resolution_clock> end_point
-            = std::chrono::high_resolution_clock::now();
-
-        std::chrono::milliseconds deltatime
-            = std::chrono::duration_cast<std::chrono::milliseconds>(end_point - start_point);
-
-        cout_mutex.lock();
-        std::cout << "thread " << thread_id << " completed : " << deltatime.count() << "ms\n";
-        cout_mutex.unlock();
-    }
-
     /** Ƽ   BAƮũ Degree Distribution ϴ ԼԴϴ.
     */
     void TestMultiThreadDegreeDistribution()
     {
         namespace AML = AdjacencyMultiList;
 
-        const std::size_t node_number = 10000;
-        const std::size_t connection_per_step = 2;
-        const std::size_t thread_number = 10;
-        const std::size_t loop_per_thread = 10;
-
-        std::vector<double> degree_distribution;
-        std::mutex cout_mutex;
-
-        std::promise<std::vector<double>> promise;
-        std::vector<std::future<std::vector<double>>> results;
-        std::vector<std::thread> threads;
-        for(std::size_t i = 0; i < thread_number; i++)
-        {
-            promise = std::promise<std::vector<double>>();
-            results.push_back(promise.get_future());
-            threads.emplace_back(ThreadBADegreeDistribution, i, node_number, connection_per_step, loop_per_thread, std::ref(cout_mutex), std::move(promise));
-        }
+        const int node_number = 10000;
+        const int connection_per_step = 2;
+        const int thread_number = 10;
+        const int replicate_number = 100;
+        const std::uint64_t seed = 42;
 
-        for(std::size_t i = 0; i < thread_number; i++)
+        //fraction of vertices of each degree in one replicate
+        auto MeasureDegree = [](AML::Graph<int, float>* network, Network::CounterRandom&)
         {
-            threads[i].join();
-            std::vector<double> result = results[i].get();
-            if(result.size() > degree_distribution.size())
+            std::vector<double> degree_distribution(network->vertex_list.size(), 0.0);
+            for(AML::Vertex<int, float>* vertex : network->vertex_list)
             {
-                degree_distribution.resize(result.size(), 0.0);
+                degree_distribution[vertex->GetDegree()] += 1.0 / network->vertex_list.size();
             }
-            for(std::size_t j = 0; j < result.size(); j++)
+            return degree_distribution;
+        };
+
+        //replicates are added up in their order, so the sum doesn't depend on threads
+        auto Average = [node_number, replicate_number](const std::vector<std::vector<double>>& results)
+        {
+            std::vector<double> degree_distribution(node_number, 0.0);
+            for(const std::vector<double>& result : results)
             {
-                degree_distribution[j] += result[j];
+                for(std::size_t j = 0; j < result.size(); j++)
+                {
+                    degree_distribution[j] += result[j] / replicate_number;
+                }
             }
-        }
-        for(std::size_t j = 0; j < degree_distribution.size(); j++)
-        {
-            degree_distribution[j] /= int(thread_number);
-        }
+            return degree_distribution;
+        };
+
+        ThreadPool pool(thread_number);
+        BenchMark::Timer timer1("RunEnsemble");
+        std::vector<double> degree_distribution
+            = Average(Network::RunEnsemble(pool, node_number, replicate_number, seed, Network::BAGenerator{connection_per_step}, MeasureDegree));
+        timer1.Stop();
+
+        ThreadPool single_pool(1);
+        BenchMark::Timer timer2("RunEnsemble(1 thread)");
+        std::vector<double> single_degree_distribution
+            = Average(Network::RunEnsemble(single_pool, node_number, replicate_number, seed, Network::BAGenerator{connection_per_step}, MeasureDegree));
+        timer2.Stop();
 
         for(int i = 0; i < 20; i++)
         {
             std::cout << std::setw(10) << degree_distribution[i] << " " << std::string(degree_distribution[i] / 0.01, '*') << "\n";
         }
+        std::cout << "Same Distribution : " << ((degree_distribution == single_degree_distribution) ? "true" : "false") << std::endl;
+
+        std::cout << "\n" << std::string(30, '*') << "\n\n";
     }
 
     void TestPrimAlgorithm(int network_size, int connection_step)
@@ -297,9 +318,15 @@ namespace Test
                                              &network, 0);
         timer.Stop();
 
+        std::vector<AML::Edge<int, float>*> kruskal_result = MST::KruskalAlgorithm(AML::EdgeData(), &network);
+        double weight = 0.0, kruskal_weight = 0.0;
+        for(AML::Edge<int, float>* edge : result) weight += edge->data;
+        for(AML::Edge<int, float>* edge : kruskal_result) kruskal_weight += edge->data;
+
         std::cout << "Graph Vertex Count : " << network.vertex_list.size() << std::endl;
         std::cout << "Graph Edge Count : " << network.GetEdgeNumber() << std::endl;
         std::cout << "Spanning Tree Edge Count : " << result.size() << std::endl;
+        std::cout << "Spanning Tree Weight : " << weight << " / " << kruskal_weight << " (Kruskal)" << std::endl;
         
         std::cout << "\n" << std::string(30, '*') << "\n\n";
     }
@@ -344,9 +371,24 @@ namespace Test
                                              &network);
         timer.Stop();
 
+        //same weights through a function pointer, which can't be inlined into the comparator
+        float (*GetWeightPointer)(AML::Edge<int, float>* &) = [](AML::Edge<int, float>* &target_edge)->float{return target_edge->data; };
+        BenchMark::Timer timer2("KruskalAlgorithm(function pointer)");
+        std::vector<AML::Edge<int, float>*> pointer_result = MST::KruskalAlgorithm<int, float>(GetWeightPointer, &network);
+        timer2.Stop();
+
+        BenchMark::Timer timer3("KruskalAlgorithm(AML::EdgeData)");
+        std::vector<AML::Edge<int, float>*> data_result = MST::KruskalAlgorithm(AML::EdgeData(), &network);
+        timer3.Stop();
+
+        BenchMark::Timer timer4("KruskalAlgorithm(AML::EdgeData, 1 thread)");
+        std::vector<AML::Edge<int, float>*> serial_result = MST::KruskalAlgorithm(AML::EdgeData(), &network, MST::WeightStorage::Pointer, 1);
+        timer4.Stop();
+
         std::cout << "Graph Vertex Count : " << network.vertex_list.size() << std::endl;
         std::cout << "Graph Edge Count : " << network.GetEdgeNumber() << std::endl;
         std::cout << "Spanning Tree Edge Count : " << result.size() << std::endl;
+        std::cout << "Same Tree : " << ((pointer_result == result && data_result == result && serial_result == result) ? "true" : "false") << std::endl;
 
         std::cout << "\n" << std::string(30, '*') << "\n\n";
 
@@ -525,6 +567,994 @@ namespace Test
             std::cout << line << std::endl;
 
         std::cout << "\n" << std::string(30, '*') << "\n\n";
+
+        //every weight is 1, so breadth first search gives the same path
+        std::vector<AML::Vertex<std::pair<int, int>, float>*> dijkstra_result = result;
+        BenchMark::Timer timer3("DijkstraAlgorithmPath (WeightType::Uniform)");
+
+        result
+            = ShortestPath::DijkstraAlgorithmPath<std::pair<int, int>, float>(&lattice, GetWeight, start_vertex, end_vertex, ShortestPath::WeightType::Uniform);
+
+        timer3.Stop();
+        std::cout << "Distance Count : " << result.size() << std::endl;
+        std::cout << "Same Path As Dijkstra : " << (result == dijkstra_result ? "true" : "false") << std::endl;
+
+        std::cout << "\n" << std::string(30, '*') << "\n\n";
+    }
+
+    void TestCompressedGraph(int network_size, int connection_step)
+    {
+        std::cout << "Creating BA Network Graph\n";
+        namespace AML = AdjacencyMultiList;
+        namespace MST = MinimunSpanningTree;
+        AML::Graph<int, float> network(network_size);
+        Network::InitializeBANetwork(&network, connection_step, network_size);
+
+        std::minstd_rand generator(42);
+
+        std::uniform_real_distribution<float> uniform_dist(0.1f, 1.0f);
+
+        std::cout << "Initialize Edge weight\n";
+        network.ResetAllEdgeMark();
+        for(AML::Vertex<int, float>* vertex : network.vertex_list)
+        {
+            AML::Edge<int, float>* current_edge = vertex->GetFront();
+            while(current_edge != nullptr)
+            {
+                if(!current_edge->mark)
+                {
+                    current_edge->data = uniform_dist(generator);
+                    current_edge->mark = true;
+                }
+                current_edge = current_edge->GetNext(vertex);
+            }
+        }
+        network.ResetAllEdgeMark();
+
+        auto GetWeight = [](AML::Edge<int, float>* &target_edge)->float{return target_edge->data; };
+
+        auto PathLength = [](std::vector<AML::Vertex<int, float>*> path, AML::Vertex<int, float>* start_vertex, AML::Vertex<int, float>* end_vertex)->float
+        {
+            path.insert(path.begin(), start_vertex);
+            path.push_back(end_vertex);
+            float length = 0.0f;
+            for(std::size_t i = 0; i + 1 < path.size(); i++)
+            {
+                float shortest = std::numeric_limits<float>::max();
+                for(AML::Edge<int, float>* edge : path[i]->GetEdges())
+                {
+                    if(edge->GetOpposite(path[i]) == path[i + 1]) shortest = std::min(shortest, edge->data);
+                }
+                length += shortest;
+            }
+            return length;
+        };
+
+        auto TreeWeight = [](const std::vector<AML::Edge<int, float>*>& edges)->double
+        {
+            double sum = 0.0;
+            for(AML::Edge<int, float>* edge : edges) sum += edge->data;
+            return sum;
+        };
+
+        BenchMark::Timer build_timer("CompressedGraph Build");
+        AML::CompressedGraph<int, float> snapshot(&network, GetWeight);
+        build_timer.Stop();
+
+        AML::Vertex<int, float>* start_vertex = network.vertex_list[10];
+        AML::Vertex<int, float>* end_vertex = network.vertex_list[network_size / 2];
+
+        BenchMark::Timer timer1("DijkstraAlgorithmPath(Graph)");
+        std::vector<AML::Vertex<int, float>*> path = ShortestPath::DijkstraAlgorithmPath<int, float>(&network, GetWeight, start_vertex, end_vertex);
+        timer1.Stop();
+
+        BenchMark::Timer timer2("DijkstraAlgorithmPath(CompressedGraph)");
+        std::vector<AML::Vertex<int, float>*> compressed_path = ShortestPath::DijkstraAlgorithmPath(&snapshot, start_vertex, end_vertex);
+        timer2.Stop();
+
+        std::cout << "Path Length : " << PathLength(path, start_vertex, end_vertex) << " / " << PathLength(compressed_path, start_vertex, end_vertex) << "\n";
+
+        BenchMark::Timer timer3("KruskalAlgorithm(Graph)");
+        std::vector<AML::Edge<int, float>*> tree = MST::KruskalAlgorithm<int, float>(GetWeight, &network);
+        timer3.Stop();
+
+        BenchMark::Timer timer4("KruskalAlgorithm(CompressedGraph)");
+        std::vector<AML::Edge<int, float>*> compressed_tree = MST::KruskalAlgorithm(&snapshot);
+        timer4.Stop();
+
+        BenchMark::Timer timer5("PrimAlgorithm(CompressedGraph)");
+        std::vector<AML::Edge<int, float>*> compressed_prim_tree = MST::PrimAlgorithm(&snapshot, 0);
+        timer5.Stop();
+
+        BenchMark::Timer timer6("KruskalAlgorithm(Graph, WeightStorage::Dense)");
+        std::vector<AML::Edge<int, float>*> dense_tree = MST::KruskalAlgorithm<int, float>(GetWeight, &network, MST::WeightStorage::Dense);
+        timer6.Stop();
+
+        BenchMark::Timer timer7("PrimAlgorithm(Graph, WeightStorage::Dense)");
+        std::vector<AML::Edge<int, float>*> dense_prim_tree = MST::PrimAlgorithm<int, float>(GetWeight, &network, 0, MST::WeightStorage::Dense);
+        timer7.Stop();
+
+        std::cout << "Spanning Tree Weight : " << TreeWeight(tree) << " / " << TreeWeight(compressed_tree) << " / " << TreeWeight(compressed_prim_tree)
+                  << " / " << TreeWeight(dense_tree) << " / " << TreeWeight(dense_prim_tree) << "\n";
+
+        std::vector<std::vector<AML::Vertex<int, float>*>> clusters;
+        std::vector<std::vector<AML::Vertex<int, float>*>> compressed_clusters;
+        Network::FindClusters(&network, clusters);
+        Network::FindClusters(&snapshot, compressed_clusters);
+        std::cout << "Cluster Count : " << clusters.size() << " / " << compressed_clusters.size() << "\n";
+
+        std::cout << "\n" << std::string(30, '*') << "\n\n";
+    }
+
+    void TestPathQueryContext(int network_size, int connection_step, int query_number)
+    {
+        std::cout << "Creating BA Network Graph\n";
+        namespace AML = AdjacencyMultiList;
+        AML::Graph<int, float> network(network_size);
+        Network::InitializeBANetwork(&network, connection_step, network_size);
+
+        std::minstd_rand generator(42);
+
+        auto GetWeight = [](AML::Edge<int, float>* &target_edge)->float{return target_edge->data; };
+
+        std::vector<std::pair<int, int>> queries;
+        for(int i = 0; i < query_number; i++)
+        {
+            queries.emplace_back(GetRandomIndex(generator, network_size), GetRandomIndex(generator, network_size));
+        }
+
+        std::size_t path_size_sum = 0;
+        BenchMark::Timer timer1("DijkstraAlgorithmPath(Graph)");
+        for(std::pair<int, int> query : queries)
+        {
+            path_size_sum += ShortestPath::DijkstraAlgorithmPath<int, float>(&network, GetWeight, network.vertex_list[query.first], network.vertex_list[query.second]).size();
+        }
+        timer1.Stop();
+
+        std::size_t context_path_size_sum = 0;
+        long long settled_sum = 0;
+        ShortestPath::PathQueryContext<int, float> context(&network);
+        BenchMark::Timer timer2("DijkstraAlgorithmPath(PathQueryContext)");
+        for(std::pair<int, int> query : queries)
+        {
+            context_path_size_sum += ShortestPath::DijkstraAlgorithmPath<int, float>(&context, GetWeight, network.vertex_list[query.first], network.vertex_list[query.second]).size();
+            settled_sum += context.GetSettledCount();
+        }
+        timer2.Stop();
+
+        std::cout << "Path Size Sum : " << path_size_sum << " / " << context_path_size_sum << "\n";
+        std::cout << "Mean Settled Vertices : " << double(settled_sum) / query_number << "\n";
+
+        std::cout << "\n" << std::string(30, '*') << "\n\n";
+    }
+
+    void TestBidirectionalDijkstra(int network_size, int connection_step, int query_number)
+    {
+        std::cout << "Creating BA Network Graph\n";
+        namespace AML = AdjacencyMultiList;
+        AML::Graph<int, float> network(network_size);
+        Network::InitializeBANetwork(&network, connection_step, network_size);
+
+        std::minstd_rand generator(42);
+
+        std::uniform_real_distribution<float> uniform_dist(0.1f, 1.0f);
+
+        network.ResetAllEdgeMark();
+        for(AML::Vertex<int, float>* vertex : network.vertex_list)
+        {
+            AML::Edge<int, float>* current_edge = vertex->GetFront();
+            while(current_edge != nullptr)
+            {
+                if(!current_edge->mark)
+                {
+                    current_edge->data = uniform_dist(generator);
+                    current_edge->mark = true;
+                }
+                current_edge = current_edge->GetNext(vertex);
+            }
+        }
+        network.ResetAllEdgeMark();
+
+        auto GetWeight = [](AML::Edge<int, float>* &target_edge)->float{return target_edge->data; };
+
+        ShortestPath::PathQueryContext<int, float> context(&network);
+
+        long long settled_sum = 0;
+        long long bidirectional_settled_sum = 0;
+        int different_path_count = 0;
+        for(int i = 0; i < query_number; i++)
+        {
+            AML::Vertex<int, float>* start_vertex = network.vertex_list[GetRandomIndex(generator, network_size)];
+            AML::Vertex<int, float>* end_vertex = network.vertex_list[GetRandomIndex(generator, network_size)];
+
+            std::vector<AML::Vertex<int, float>*> path = ShortestPath::DijkstraAlgorithmPath<int, float>(&context, GetWeight, start_vertex, end_vertex);
+            settled_sum += context.GetSettledCount();
+
+            std::vector<AML::Vertex<int, float>*> bidirectional_path = ShortestPath::BidirectionalDijkstraPath<int, float>(&context, GetWeight, start_vertex, end_vertex);
+            bidirectional_settled_sum += context.GetSettledCount();
+
+            if(path != bidirectional_path) ++different_path_count;
+        }
+
+        std::cout << "Mean Settled Vertices : " << double(settled_sum) / query_number << " / " << double(bidirectional_settled_sum) / query_number << "\n";
+        std::cout << "Different Path Count : " << different_path_count << "\n";
+
+        std::cout << "\n" << std::string(30, '*') << "\n\n";
+    }
+
+    void TestContractionHierarchy(int x_size, int y_size, int network_size, int connection_step, int query_number)
+    {
+        namespace AML = AdjacencyMultiList;
+        std::minstd_rand generator(42);
+
+        auto Compare = [&generator, query_number](AML::Graph<int, float>* network)
+        {
+            const int size = int(network->vertex_list.size());
+            std::uniform_real_distribution<float> uniform_dist(0.1f, 1.0f);
+
+            network->ResetAllEdgeMark();
+            for(AML::Vertex<int, float>* vertex : network->vertex_list)
+            {
+                AML::Edge<int, float>* current_edge = vertex->GetFront();
+                while(current_edge != nullptr)
+                {
+                    if(!current_edge->mark)
+                    {
+                        current_edge->data = uniform_dist(generator);
+                        current_edge->mark = true;
+                    }
+                    current_edge = current_edge->GetNext(vertex);
+                }
+            }
+            network->ResetAllEdgeMark();
+
+            auto GetWeight = [](AML::Edge<int, float>* &target_edge)->float{return target_edge->data; };
+
+            ShortestPath::ContractionHierarchy<int, float> hierarchy(network, GetWeight);
+            std::cout << "Preprocess Time : " << hierarchy.GetPreprocessTime() << "ms\n";
+            std::cout << "Shortcut Number : " << hierarchy.GetShortcutNumber() << " (original edges : " << network->GetEdgeNumber() << ")\n";
+            std::cout << "Core Vertex Number : " << hierarchy.GetCoreNumber() << "\n";
+            std::cout << "Memory Usage : " << hierarchy.GetMemoryUsage() << " bytes\n";
+
+            ShortestPath::PathQueryContext<int, float> context(network);
+
+            long long settled_sum = 0;
+            long long hierarchy_settled_sum = 0;
+            int different_path_count = 0;
+            for(int i = 0; i < query_number; i++)
+            {
+                AML::Vertex<int, float>* start_vertex = network->vertex_list[GetRandomIndex(generator, size)];
+                AML::Vertex<int, float>* end_vertex = network->vertex_list[GetRandomIndex(generator, size)];
+
+                std::vector<AML::Vertex<int, float>*> path = ShortestPath::DijkstraAlgorithmPath<int, float>(&context, GetWeight, start_vertex, end_vertex);
+                settled_sum += context.GetSettledCount();
+
+                std::vector<AML::Vertex<int, float>*> hierarchy_path = hierarchy.FindPath(start_vertex, end_vertex);
+                hierarchy_settled_sum += hierarchy.GetSettledCount();
+
+                if(path != hierarchy_path) ++different_path_count;
+            }
+
+            std::cout << "Mean Settled Vertices : " << double(settled_sum) / query_number << " / " << double(hierarchy_settled_sum) / query_number << "\n";
+            std::cout << "Different Path Count : " << different_path_count << "\n";
+        };
+
+        std::cout << "Creating Lattice Network Graph\n";
+        AML::Graph<int, float> lattice(x_size * y_size);
+        Network::InitializeLatticeNetwork(&lattice, x_size, y_size);
+        Compare(&lattice);
+
+        //contraction of BA network stops at its dense core
+        std::cout << "\nCreating BA Network Graph\n";
+        AML::Graph<int, float> network(network_size);
+        network.Initialize(network_size);
+        Network::ConnectBANetwork(&network, connection_step, 42);
+        Compare(&network);
+
+        std::cout << "\n" << std::string(30, '*') << "\n\n";
+    }
+
+    void TestLandmarks(int network_size, int connection_step, int landmark_number, int query_number)
+    {
+        std::cout << "Creating BA Network Graph\n";
+        namespace AML = AdjacencyMultiList;
+        AML::Graph<int, float> network(network_size);
+        Network::InitializeBANetwork(&network, connection_step, network_size);
+
+        std::minstd_rand generator(42);
+
+        std::uniform_real_distribution<float> uniform_dist(0.1f, 1.0f);
+
+        network.ResetAllEdgeMark();
+        for(AML::Vertex<int, float>* vertex : network.vertex_list)
+        {
+            AML::Edge<int, float>* current_edge = vertex->GetFront();
+            while(current_edge != nullptr)
+            {
+                if(!current_edge->mark)
+                {
+                    current_edge->data = uniform_dist(generator);
+                    current_edge->mark = true;
+                }
+                current_edge = current_edge->GetNext(vertex);
+            }
+        }
+        network.ResetAllEdgeMark();
+
+        auto GetWeight = [](AML::Edge<int, float>* &target_edge)->float{return target_edge->data; };
+
+        BenchMark::Timer timer("Landmarks");
+        ShortestPath::Landmarks<int, float> landmarks(&network, GetWeight, landmark_number);
+        timer.Stop();
+        std::cout << "Memory Usage : " << landmarks.GetMemoryUsage() << " bytes\n";
+
+        ShortestPath::PathQueryContext<int, float> context(&network);
+
+        long long settled_sum = 0;
+        long long landmark_settled_sum = 0;
+        long long bidirectional_settled_sum = 0;
+        int different_path_count = 0;
+        for(int i = 0; i < query_number; i++)
+        {
+            AML::Vertex<int, float>* start_vertex = network.vertex_list[GetRandomIndex(generator, network_size)];
+            AML::Vertex<int, float>* end_vertex = network.vertex_list[GetRandomIndex(generator, network_size)];
+
+            std::vector<AML::Vertex<int, float>*> path = ShortestPath::DijkstraAlgorithmPath<int, float>(&context, GetWeight, start_vertex, end_vertex);
+            settled_sum += context.GetSettledCount();
+
+            std::vector<AML::Vertex<int, float>*> landmark_path = ShortestPath::AStarAlgorithm<int, float>(&context, GetWeight, landmarks, start_vertex, end_vertex);
+            landmark_settled_sum += context.GetSettledCount();
+            if(path != landmark_path) ++different_path_count;
+
+            landmark_path = ShortestPath::BidirectionalAStarAlgorithm<int, float>(&context, GetWeight, landmarks, start_vertex, end_vertex);
+            bidirectional_settled_sum += context.GetSettledCount();
+            if(path != landmark_path) ++different_path_count;
+        }
+
+        std::cout << "Mean Settled Vertices (Dijkstra / A* / Bidirectional A*) : " << double(settled_sum) / query_number
+            << " / " << double(landmark_settled_sum) / query_number << " / " << double(bidirectional_settled_sum) / query_number << "\n";
+        std::cout << "Different Path Count : " << different_path_count << "\n";
+
+        std::cout << "\n" << std::string(30, '*') << "\n\n";
+    }
+
+    void TestDeltaStepping(int network_size, int connection_step, int thread_number)
+    {
+        std::cout << "Creating BA Network Graph\n";
+        namespace AML = AdjacencyMultiList;
+        AML::Graph<int, float> network(network_size);
+        Network::InitializeBANetwork(&network, connection_step, network_size);
+
+        std::minstd_rand generator(42);
+
+        std::uniform_real_distribution<float> uniform_dist(0.1f, 1.0f);
+
+        network.ResetAllEdgeMark();
+        for(AML::Vertex<int, float>* vertex : network.vertex_list)
+        {
+            AML::Edge<int, float>* current_edge = vertex->GetFront();
+            while(current_edge != nullptr)
+            {
+                if(!current_edge->mark)
+                {
+                    current_edge->data = uniform_dist(generator);
+                    current_edge->mark = true;
+                }
+                current_edge = current_edge->GetNext(vertex);
+            }
+        }
+        network.ResetAllEdgeMark();
+
+        auto GetWeight = [](AML::Edge<int, float>* &target_edge)->float{return target_edge->data; };
+
+        AML::Vertex<int, float>* start_vertex = network.vertex_list[GetRandomIndex(generator, network_size)];
+        AML::CompressedGraph<int, float> snapshot(&network, GetWeight);
+
+        BenchMark::Timer timer1("DijkstraAlgorithmTree");
+        std::vector<AML::Edge<int, float>*> tree = ShortestPath::DijkstraAlgorithmTree<int, float>(&network, GetWeight, start_vertex);
+        timer1.Stop();
+
+        BenchMark::Timer timer2("DeltaSteppingTree");
+        std::vector<AML::Edge<int, float>*> delta_tree = ShortestPath::DeltaSteppingTree(&snapshot, start_vertex, 0.0f, thread_number);
+        timer2.Stop();
+
+        //distance of each vertex, by following the tree to start_vertex
+        auto GetTreeDistances = [&network, start_vertex](std::vector<AML::Edge<int, float>*>& target_tree)->std::vector<float>
+        {
+            std::vector<float> distances(network.vertex_list.size(), -1.0f);
+            distances[start_vertex->index] = 0.0f;
+            std::vector<int> stack;
+            for(int i = 0; i < int(network.vertex_list.size()); i++)
+            {
+                int current_index = i;
+                while(distances[current_index] < 0.0f && target_tree[current_index] != nullptr)
+                {
+                    stack.push_back(current_index);
+                    current_index = target_tree[current_index]->GetOpposite(network.vertex_list[current_index])->index;
+                }
+                while(!stack.empty())
+                {
+                    int index = stack.back();
+                    stack.pop_back();
+                    int previous_index = target_tree[index]->GetOpposite(network.vertex_list[index])->index;
+                    if(distances[previous_index] >= 0.0f) distances[index] = distances[previous_index] + target_tree[index]->data;
+                }
+            }
+            return distances;
+        };
+
+        std::vector<float> distances = GetTreeDistances(tree);
+        std::vector<float> delta_distances = GetTreeDistances(delta_tree);
+        int different_distance_count = 0;
+        for(std::size_t i = 0; i < distances.size(); i++)
+        {
+            if(std::abs(distances[i] - delta_distances[i]) > 1e-3f) ++different_distance_count;
+        }
+        std::cout << "Different Distance Count : " << different_distance_count << "\n";
+
+        std::cout << "\n" << std::string(30, '*') << "\n\n";
+    }
+
+    void TestMultiSourceDijkstra(int network_size, int connection_step, int source_number, int thread_number)
+    {
+        std::cout << "Creating BA Network Graph\n";
+        namespace AML = AdjacencyMultiList;
+        AML::Graph<int, float> network(network_size);
+        Network::InitializeBANetwork(&network, connection_step, network_size);
+
+        std::minstd_rand generator(42);
+
+        std::uniform_real_distribution<float> uniform_dist(0.1f, 1.0f);
+
+        network.ResetAllEdgeMark();
+        for(AML::Vertex<int, float>* vertex : network.vertex_list)
+        {
+            AML::Edge<int, float>* current_edge = vertex->GetFront();
+            while(current_edge != nullptr)
+            {
+                if(!current_edge->mark)
+                {
+                    current_edge->data = uniform_dist(generator);
+                    current_edge->mark = true;
+                }
+                current_edge = current_edge->GetNext(vertex);
+            }
+        }
+        network.ResetAllEdgeMark();
+
+        auto GetWeight = [](AML::Edge<int, float>* &target_edge)->float{return target_edge->data; };
+
+        std::vector<AML::Vertex<int, float>*> sources;
+        for(int i = 0; i < source_number; i++)
+        {
+            sources.push_back(network.vertex_list[GetRandomIndex(generator, network_size)]);
+        }
+
+        AML::CompressedGraph<int, float> snapshot(&network, GetWeight);
+
+        std::vector<std::vector<AML::Edge<int, float>*>> trees;
+        BenchMark::Timer timer1("DijkstraAlgorithmTree Loop");
+        for(AML::Vertex<int, float>* source : sources)
+        {
+            trees.push_back(ShortestPath::DijkstraAlgorithmTree<int, float>(&network, GetWeight, source));
+        }
+        timer1.Stop();
+
+        ThreadPool pool(thread_number);
+        std::mutex result_mutex;
+        int different_tree_count = 0;
+        int finished_count = 0;
+        BenchMark::Timer timer2("MultiSourceDijkstraTree");
+        ShortestPath::MultiSourceDijkstraTree(&snapshot, sources, pool,
+            [&](int request_index, std::vector<AML::Edge<int, float>*>& tree)
+            {
+                std::lock_guard<std::mutex> lock(result_mutex);
+                if(tree != trees[request_index]) ++different_tree_count;
+                ++finished_count;
+            });
+        timer2.Stop();
+
+        std::cout << "Finished Trees : " << finished_count << " / " << source_number << "\n";
+        std::cout << "Different Tree Count : " << different_tree_count << "\n";
+
+        std::cout << "\n" << std::string(30, '*') << "\n\n";
+    }
+
+    void TestBoruvkaAlgorithm(int network_size, int mean_degree, int thread_number)
+    {
+        std::cout << "Creating ER Network Graph\n";
+        namespace AML = AdjacencyMultiList;
+        namespace MST = MinimunSpanningTree;
+        AML::Graph<int, float> network(network_size);
+        Network::InitializeERNetwork(&network, mean_degree, network_size);
+
+        std::minstd_rand generator(42);
+
+        std::uniform_real_distribution<float> uniform_dist(0.1f, 1.0f);
+
+        network.ResetAllEdgeMark();
+        for(AML::Vertex<int, float>* vertex : network.vertex_list)
+        {
+            AML::Edge<int, float>* current_edge = vertex->GetFront();
+            while(current_edge != nullptr)
+            {
+                if(!current_edge->mark)
+                {
+                    current_edge->data = uniform_dist(generator);
+                    current_edge->mark = true;
+                }
+                current_edge = current_edge->GetNext(vertex);
+            }
+        }
+        network.ResetAllEdgeMark();
+
+        BenchMark::Timer timer1("KruskalAlgorithm");
+        std::vector<AML::Edge<int, float>*> forest = MST::KruskalAlgorithm(AML::EdgeData(), &network, MST::WeightStorage::Pointer, thread_number);
+        timer1.Stop();
+
+        BenchMark::Timer timer2("BoruvkaAlgorithm");
+        std::vector<AML::Edge<int, float>*> boruvka_forest = MST::BoruvkaAlgorithm(AML::EdgeData(), &network, thread_number);
+        timer2.Stop();
+
+        std::vector<std::vector<AML::Vertex<int, float>*>> clusters;
+        Network::FindClusters(&network, clusters);
+
+        std::cout << "Graph Vertex Count : " << network.vertex_list.size() << std::endl;
+        std::cout << "Graph Edge Count : " << network.GetEdgeNumber() << std::endl;
+        std::cout << "Cluster Count : " << clusters.size() << std::endl;
+        std::cout << "Spanning Forest Edge Count : " << forest.size() << " / " << boruvka_forest.size() << std::endl;
+        std::cout << "Same Forest : " << ((forest == boruvka_forest) ? "true" : "false") << std::endl;
+
+        std::cout << "\n" << std::string(30, '*') << "\n\n";
+    }
+
+    void TestUnionFindTree(int size, int union_number, int thread_number)
+    {
+        if(thread_number <= 0) thread_number = 1;
+
+        //chain which the tree without union by size made in linear depth
+        UnionFindTree chain_tree(size);
+        BenchMark::Timer timer1("UnionFindTree Chain");
+        for(int i = size - 1; i > 0; i--)
+        {
+            chain_tree.Union(i - 1, i);
+        }
+        long long root_sum = 0;
+        for(int i = 0; i < size; i++)
+        {
+            root_sum += chain_tree.Find(i);
+        }
+        timer1.Stop();
+
+        std::minstd_rand generator(42);
+        std::uniform_int_distribution<int> index_dist(0, size - 1);
+        std::vector<std::pair<int, int>> pairs(union_number);
+        for(std::pair<int, int>& pair : pairs)
+        {
+            pair = std::make_pair(index_dist(generator), index_dist(generator));
+        }
+
+        UnionFindTree union_find_tree(size);
+        BenchMark::Timer timer2("UnionFindTree Random");
+        int merge_number = 0;
+        for(const std::pair<int, int>& pair : pairs)
+        {
+            if(union_find_tree.Union(pair.first, pair.second)) ++merge_number;
+        }
+        timer2.Stop();
+
+        ConcurrentUnionFindTree concurrent_tree(size);
+        std::vector<int> merge_numbers(thread_number, 0);
+        BenchMark::Timer timer3("ConcurrentUnionFindTree Random");
+        std::vector<std::thread> threads;
+        for(int t = 0; t < thread_number; t++)
+        {
+            threads.emplace_back([&, t]()
+            {
+                const int begin = int((long long)union_number * t / thread_number);
+                const int end = int((long long)union_number * (t + 1) / thread_number);
+                for(int i = begin; i < end; i++)
+                {
+                    if(concurrent_tree.Union(pairs[i].first, pairs[i].second)) ++merge_numbers[t];
+                }
+            });
+        }
+        for(std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        timer3.Stop();
+        int concurrent_merge_number = 0;
+        for(int number : merge_numbers) concurrent_merge_number += number;
+
+        std::vector<int> indices(size);
+        for(int i = 0; i < size; i++) indices[i] = i;
+        std::vector<int> roots, concurrent_roots;
+        union_find_tree.Find(indices, roots);
+        concurrent_tree.Find(indices, concurrent_roots);
+
+        //same partition if the roots of one tree map to the roots of the other one to one
+        std::vector<int> root_map(size, -1);
+        bool same_sets = true;
+        for(int i = 0; i < size && same_sets; i++)
+        {
+            if(root_map[roots[i]] == -1) root_map[roots[i]] = concurrent_roots[i];
+            else if(root_map[roots[i]] != concurrent_roots[i]) same_sets = false;
+        }
+
+        std::cout << "Chain Root Sum : " << root_sum << std::endl;
+        std::cout << "Set Count : " << size - merge_number << " / " << size - concurrent_merge_number << std::endl;
+        std::cout << "Same Sets : " << ((same_sets && merge_number == concurrent_merge_number) ? "true" : "false") << std::endl;
+
+        std::cout << "\n" << std::string(30, '*') << "\n\n";
+    }
+
+    void TestERNetwork(int network_size, int mean_degree, int thread_number)
+    {
+        namespace AML = AdjacencyMultiList;
+        const double probability = double(mean_degree) / double(network_size - 1);
+
+        //edges as sorted index pairs, to compare networks
+        auto GetEdgePairs = [](AML::Graph<int, float>& network)
+        {
+            network.ResetVertexIndex();
+            std::vector<std::pair<int, int>> edge_pairs;
+            for(AML::Vertex<int, float>* vertex : network.vertex_list)
+            {
+                for(AML::Edge<int, float>* edge : vertex->GetEdges())
+                {
+                    if(edge->GetVertex(0) == vertex) edge_pairs.emplace_back(edge->GetVertex(0)->index, edge->GetVertex(1)->index);
+                }
+            }
+            std::sort(edge_pairs.begin(), edge_pairs.end());
+            return edge_pairs;
+        };
+
+        AML::Graph<int, float> network;
+        network.Initialize(network_size);
+        AML::Graph<int, float> thread_network;
+        thread_network.Initialize(network_size);
+
+        BenchMark::Timer timer1("ConnectGNPNetwork(1 thread)");
+        Network::ConnectGNPNetwork(&network, probability, 42, 1);
+        timer1.Stop();
+
+        BenchMark::Timer timer2("ConnectGNPNetwork");
+        Network::ConnectGNPNetwork(&thread_network, probability, 42, thread_number);
+        timer2.Stop();
+
+        std::cout << "Graph Vertex Count : " << network.vertex_list.size() << std::endl;
+        std::cout << "G(n, p) Edge Count : " << network.GetEdgeNumber() << " (expected " << double(network_size) * mean_degree / 2 << ")" << std::endl;
+        std::cout << "Same Network : " << ((GetEdgePairs(network) == GetEdgePairs(thread_network)) ? "true" : "false") << std::endl;
+
+        BenchMark::Timer timer3("ConnectGNMNetwork");
+        Network::ConnectGNMNetwork(&network, (long long)network_size * mean_degree / 2, 42);
+        timer3.Stop();
+
+        std::cout << "G(n, m) Edge Count : " << network.GetEdgeNumber() << std::endl;
+
+        std::cout << "\n" << std::string(30, '*') << "\n\n";
+    }
+
+    void TestConnectedComponents(int network_size, int mean_degree, int thread_number)
+    {
+        std::cout << "Creating ER Network Graph\n";
+        namespace AML = AdjacencyMultiList;
+        AML::Graph<int, float> network(network_size);
+        network.Initialize(network_size);
+        Network::ConnectGNPNetwork(&network, double(mean_degree) / (network_size - 1), 42);
+
+        AML::CompressedGraph<int, float> snapshot(&network, AML::EdgeData());
+
+        BenchMark::Timer timer1("ConnectedComponents(1 thread)");
+        Network::ConnectedComponents<int, float> single_components(&network, 1);
+        timer1.Stop();
+
+        BenchMark::Timer timer2("ConnectedComponents");
+        Network::ConnectedComponents<int, float> components(&network, thread_number);
+        timer2.Stop();
+
+        BenchMark::Timer timer3("ConnectedComponents(CompressedGraph)");
+        Network::ConnectedComponents<int, float> compressed_components(&snapshot, thread_number);
+        timer3.Stop();
+
+        //every edge must join vertices of same component
+        bool is_consistent = true;
+        for(AML::Vertex<int, float>* vertex : network.vertex_list)
+        {
+            for(AML::Vertex<int, float>* opposite : vertex->GetOpposites())
+            {
+                if(components.component_ids[vertex->index] != components.component_ids[opposite->index]) is_consistent = false;
+            }
+        }
+
+        std::cout << "Graph Vertex Count : " << network.vertex_list.size() << std::endl;
+        std::cout << "Component Count : " << components.GetComponentNumber() << " / " << single_components.GetComponentNumber()
+                  << " / " << compressed_components.GetComponentNumber() << std::endl;
+        std::cout << "Largest Component Size : " << components.component_sizes[components.GetLargestComponent()] << std::endl;
+        std::cout << "Same Components : " << ((is_consistent && components.component_ids == single_components.component_ids
+                                               && components.component_ids == compressed_components.component_ids) ? "true" : "false") << std::endl;
+
+        std::cout << "\n" << std::string(30, '*') << "\n\n";
+    }
+
+    void TestPercolation(int network_size, int mean_degree)
+    {
+        std::cout << "Creating ER Network Graph\n";
+        namespace AML = AdjacencyMultiList;
+        AML::Graph<int, float> network(network_size);
+        network.Initialize(network_size);
+        Network::ConnectGNPNetwork(&network, double(mean_degree) / (network_size - 1), 42);
+
+        BenchMark::Timer timer1("NewmanZiff(Bond)");
+        Network::PercolationCurve bond_curve = Network::NewmanZiff(&network, Network::PercolationMode::Bond, 42);
+        timer1.Stop();
+
+        BenchMark::Timer timer2("NewmanZiff(Site)");
+        Network::PercolationCurve site_curve = Network::NewmanZiff(&network, Network::PercolationMode::Site, 42);
+        timer2.Stop();
+
+        Network::ConnectedComponents<int, float> components(&network);
+        const int largest_size = components.component_sizes[components.GetLargestComponent()];
+        const bool same_end = bond_curve.largest_sizes.back() == largest_size && site_curve.largest_sizes.back() == largest_size
+                              && bond_curve.cluster_numbers.back() == components.GetComponentNumber()
+                              && site_curve.cluster_numbers.back() == components.GetComponentNumber();
+        const bool is_growing = std::is_sorted(bond_curve.largest_sizes.begin(), bond_curve.largest_sizes.end())
+                                && std::is_sorted(site_curve.largest_sizes.begin(), site_curve.largest_sizes.end());
+
+        std::vector<double> bond_fractions(bond_curve.largest_sizes.begin(), bond_curve.largest_sizes.end());
+        std::vector<double> site_fractions(site_curve.largest_sizes.begin(), site_curve.largest_sizes.end());
+        for(double& fraction : bond_fractions) fraction /= network_size;
+        for(double& fraction : site_fractions) fraction /= network_size;
+
+        //giant component of ER network appears at p = 1 / mean degree
+        std::cout << "Largest Cluster Fraction (bond / site)\n";
+        for(int i = 1; i <= 10; i++)
+        {
+            const double probability = i / 10.0;
+            std::cout << std::setw(5) << probability << " : " << std::setw(10) << Network::BinomialAverage(bond_fractions, probability)
+                      << " / " << std::setw(10) << Network::BinomialAverage(site_fractions, probability) << "\n";
+        }
+        std::cout << "Same Components : " << (same_end ? "true" : "false") << std::endl;
+        std::cout << "Growing Largest Cluster : " << (is_growing ? "true" : "false") << std::endl;
+
+        std::cout << "\n" << std::string(30, '*') << "\n\n";
+    }
+
+    void TestAttack(int network_size, int connection_step)
+    {
+        std::cout << "Creating BA Network Graph\n";
+        namespace AML = AdjacencyMultiList;
+        AML::Graph<int, float> network(network_size);
+        network.Initialize(network_size);
+        Network::ConnectBANetwork(&network, connection_step, 42u);
+
+        const Network::AttackStrategy strategies[] = {Network::AttackStrategy::Random, Network::AttackStrategy::Degree,
+                                                      Network::AttackStrategy::AdaptiveDegree};
+        const char* names[] = {"AttackCurve(Random)", "AttackCurve(Degree)", "AttackCurve(AdaptiveDegree)"};
+        std::vector<Network::PercolationCurve> curves;
+        for(int i = 0; i < 3; i++)
+        {
+            BenchMark::Timer timer(names[i]);
+            curves.push_back(Network::AttackCurve(&network, Network::AttackOrder(&network, strategies[i], 42)));
+            timer.Stop();
+        }
+
+        //scale-free network stands random failure, but falls apart when its hubs are attacked
+        std::cout << "Largest Cluster Fraction (random / degree / adaptive degree)\n";
+        for(int i = 0; i < 10; i++)
+        {
+            const int removed_number = network_size * i / 20;
+            std::cout << std::setw(5) << i / 20.0 << " removed : ";
+            for(int j = 0; j < 3; j++)
+            {
+                std::cout << std::setw(10) << double(curves[j].largest_sizes[removed_number]) / network_size << (j < 2 ? " / " : "\n");
+            }
+        }
+
+        std::cout << "\n" << std::string(30, '*') << "\n\n";
+    }
+
+    void TestBreadthFirstSearch(int network_size, int connection_step, int thread_number)
+    {
+        std::cout << "Creating BA Network Graph\n";
+        namespace AML = AdjacencyMultiList;
+        AML::Graph<int, float> network(network_size);
+        network.Initialize(network_size);
+        Network::ConnectBANetwork(&network, connection_step, 42u);
+
+        auto GetWeight = [](AML::Edge<int, float>* &)->float{ return 1.0f; };
+        AML::Vertex<int, float>* start_vertex = network.vertex_list.front();
+
+        BenchMark::Timer timer1("DijkstraAlgorithmTree(Uniform)");
+        std::vector<AML::Edge<int, float>*> tree
+            = ShortestPath::DijkstraAlgorithmTree(&network, GetWeight, start_vertex, ShortestPath::WeightType::Uniform);
+        timer1.Stop();
+
+        AML::CompressedGraph<int, float> snapshot(&network, GetWeight);
+        std::vector<int> single_distances, single_parents, distances, parents;
+
+        BenchMark::Timer timer2("BreadthFirstSearch(1 thread)");
+        ShortestPath::BreadthFirstSearch(&snapshot, start_vertex, single_distances, single_parents, 1);
+        timer2.Stop();
+
+        BenchMark::Timer timer3("BreadthFirstSearch");
+        ShortestPath::BreadthFirstSearch(&snapshot, start_vertex, distances, parents, thread_number);
+        timer3.Stop();
+
+        //hop distance of each vertex from the tree of Dijkstra, by following the edges to start_vertex
+        bool is_same = (distances == single_distances && parents == single_parents);
+        for(int i = 0; i < network_size; i++)
+        {
+            int hop = 0;
+            AML::Vertex<int, float>* vertex = network.vertex_list[i];
+            while(tree[vertex->index] != nullptr)
+            {
+                vertex = tree[vertex->index]->GetOpposite(vertex);
+                ++hop;
+            }
+            if(vertex != start_vertex) hop = -1;
+            if(hop != distances[i]) is_same = false;
+        }
+
+        std::cout << "Graph Vertex Count : " << network.vertex_list.size() << std::endl;
+        std::cout << "Max Hop Distance : " << *std::max_element(distances.begin(), distances.end()) << std::endl;
+        std::cout << "Same Distances : " << (is_same ? "true" : "false") << std::endl;
+
+        std::cout << "\n" << std::string(30, '*') << "\n\n";
+    }
+
+    void TestCentrality(int network_size, int connection_step, int thread_number)
+    {
+        namespace AML = AdjacencyMultiList;
+        ThreadPool pool(thread_number);
+
+        auto Compare = [&pool](AML::Graph<int, float>* network, const char* name)
+        {
+            const int size = int(network->vertex_list.size());
+            AML::CompressedGraph<int, float> snapshot(network, [](AML::Edge<int, float>*){ return 1.0f; });
+
+            BenchMark::Timer timer1("BreadthFirstSearch for every vertex");
+            std::vector<double> single_closeness(size, 0.0);
+            std::vector<int> single_eccentricities(size, 0);
+            std::vector<int> distances, parents;
+            for(int i = 0; i < size; i++)
+            {
+                ShortestPath::BreadthFirstSearch(&snapshot, network->vertex_list[i], distances, parents, 1);
+                long long distance_sum = 0;
+                int reached_number = 0;
+                for(int distance : distances)
+                {
+                    if(distance == -1) continue;
+                    distance_sum += distance;
+                    ++reached_number;
+                    single_eccentricities[i] = std::max(single_eccentricities[i], distance);
+                }
+                //Wasserman and Faust, same as (N - 1) / sum of distances on a connected graph
+                if(distance_sum != 0)
+                {
+                    single_closeness[i] = (double(reached_number - 1) / (size - 1)) * (double(reached_number - 1) / distance_sum);
+                }
+            }
+            timer1.Stop();
+
+            BenchMark::Timer timer2("ClosenessCentrality");
+            std::vector<double> closeness = Network::ClosenessCentrality(&snapshot, pool);
+            timer2.Stop();
+
+            BenchMark::Timer timer3("Eccentricities");
+            std::vector<int> eccentricities = Network::Eccentricities(&snapshot, pool);
+            timer3.Stop();
+
+            BenchMark::Timer timer4("Diameter");
+            const int diameter = Network::Diameter(&snapshot, pool);
+            timer4.Stop();
+
+            const int approximate_diameter = Network::ApproximateDiameter(&snapshot, pool, 256, 42);
+            const int max_eccentricity = *std::max_element(single_eccentricities.begin(), single_eccentricities.end());
+
+            bool is_same = (eccentricities == single_eccentricities);
+            for(int i = 0; i < size; i++)
+            {
+                if(std::abs(closeness[i] - single_closeness[i]) > 1e-12) is_same = false;
+            }
+
+            std::cout << name << " Vertex Count : " << size << std::endl;
+            std::cout << "Diameter : " << diameter << " (approximate " << approximate_diameter << ", max eccentricity " << max_eccentricity << ")" << std::endl;
+            std::cout << "Same Closeness and Eccentricities : " << (is_same ? "true" : "false") << std::endl;
+            std::cout << "Same Diameter : " << ((diameter == max_eccentricity && approximate_diameter <= diameter) ? "true" : "false") << std::endl;
+        };
+
+        std::cout << "Creating BA Network Graph\n";
+        AML::Graph<int, float> network(network_size);
+        network.Initialize(network_size);
+        Network::ConnectBANetwork(&network, connection_step, 42u);
+        Compare(&network, "BA Network");
+
+        //mean degree 1.5 leaves many clusters, for the disconnected cases of closeness and diameter
+        std::cout << "\nCreating sparse ER Network Graph\n";
+        network.Initialize(network_size);
+        Network::ConnectGNPNetwork(&network, 1.5 / (network_size - 1), 42);
+        Compare(&network, "ER Network");
+
+        std::cout << "\n" << std::string(30, '*') << "\n\n";
+    }
+
+    void TestIntegerWeight(int network_size, int connection_step)
+    {
+        std::cout << "Creating BA Network Graph\n";
+        namespace AML = AdjacencyMultiList;
+        AML::Graph<int, float> network(network_size);
+        network.Initialize(network_size);
+        Network::ConnectBANetwork(&network, connection_step, 42u);
+
+        //a fifth of the edges weigh 0, the others up to 1000, so the buckets grow from 2 to 1024
+        std::minstd_rand generator(42);
+        std::uniform_int_distribution<int> weight_dist(-250, 1000);
+        for(AML::Vertex<int, float>* vertex : network.vertex_list)
+        {
+            for(AML::Edge<int, float>* edge = vertex->GetFront(); edge != nullptr; edge = edge->GetNext(vertex))
+            {
+                if(edge->GetVertex(0) == vertex) edge->data = float(std::max(0, weight_dist(generator)));
+            }
+        }
+
+        auto CompareTrees = [](AML::Graph<int, float>* graph, AML::Vertex<int, float>* start_vertex, const char* name)->bool
+        {
+            ShortestPath::PathQueryContext<int, float, float> real_context(graph);
+            ShortestPath::PathQueryContext<int, float, float> integer_context(graph);
+            std::vector<AML::Edge<int, float>*> real_tree
+                = ShortestPath::DijkstraAlgorithmTree(&real_context, AML::EdgeData(), start_vertex, ShortestPath::WeightType::Real);
+
+            BenchMark::Timer timer(name);
+            std::vector<AML::Edge<int, float>*> integer_tree
+                = ShortestPath::DijkstraAlgorithmTree(&integer_context, AML::EdgeData(), start_vertex, ShortestPath::WeightType::Integer);
+            timer.Stop();
+
+            //the heap sums floats, so distances are compared as exact integers along the trees
+            bool is_same = (real_tree.size() == integer_tree.size());
+            for(int i = 0; is_same && i < int(graph->vertex_list.size()); i++)
+            {
+                long long real_distance = 0;
+                long long integer_distance = 0;
+                for(AML::Vertex<int, float>* vertex = graph->vertex_list[i]; real_tree[vertex->index] != nullptr;
+                    vertex = real_tree[vertex->index]->GetOpposite(vertex))
+                {
+                    real_distance += (long long)real_tree[vertex->index]->data;
+                }
+                AML::Vertex<int, float>* vertex = graph->vertex_list[i];
+                for(; integer_tree[vertex->index] != nullptr; vertex = integer_tree[vertex->index]->GetOpposite(vertex))
+                {
+                    integer_distance += (long long)integer_tree[vertex->index]->data;
+                }
+                if(vertex != start_vertex || real_distance != integer_distance) is_same = false;
+                if(integer_context.forward.GetDistance(i) != float(integer_distance)) is_same = false;
+            }
+            return is_same;
+        };
+
+        const bool is_same_network = CompareTrees(&network, network.vertex_list.front(), "DijkstraAlgorithmTree (WeightType::Integer)");
+
+        //400 vertices in a line, weights from 100001 to 300001. the far end is about 8 * 10^7 away
+        AML::Graph<int, float> chain;
+        chain.Initialize(400);
+        std::vector<std::pair<int, int>> edge_pairs;
+        for(int i = 0; i + 1 < 400; i++) edge_pairs.emplace_back(i, i + 1);
+        chain.ConnectBatch(edge_pairs);
+        for(AML::Vertex<int, float>* vertex : chain.vertex_list)
+        {
+            for(AML::Edge<int, float>* edge = vertex->GetFront(); edge != nullptr; edge = edge->GetNext(vertex))
+            {
+                if(edge->GetVertex(0) == vertex) edge->data = float(100001 + 500 * std::min(vertex->index, edge->GetOpposite(vertex)->index));
+            }
+        }
+        const bool is_same_chain = CompareTrees(&chain, chain.vertex_list.front(), "DijkstraAlgorithmTree (WeightType::Integer, chain)");
+
+        std::cout << "Graph Vertex Count : " << network.vertex_list.size() << std::endl;
+        std::cout << "Same Distances As Heap : " << (is_same_network ? "true" : "false") << std::endl;
+        std::cout << "Same Distances As Heap (chain) : " << (is_same_chain ? "true" : "false") << std::endl;
+
+        std::cout << "\n" << std::string(30, '*') << "\n\n";
     }
 
 #pragma endregion Define functions